@@ -50,6 +50,7 @@ macro(__compiler_gnu lang)
     # internally, as it ought to.  Work around this bug by setting -MT here
     # even though it isn't strictly necessary.
     set(CMAKE_DEPFILE_FLAGS_${lang} "-MD -MT <OBJECT> -MF <DEPFILE>")
+    set(CMAKE_${lang}_DEPFILE_FORMAT gcc)
   endif()
 
   # Initial configuration flags.
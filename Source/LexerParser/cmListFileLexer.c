@@ -790,6 +790,8 @@ struct cmListFileLexer_s
   char* string_buffer;
   char* string_position;
   int string_left;
+  const char* buffer;
+  size_t buffer_left;
   yyscan_t scanner;
 };
 
@@ -2642,6 +2644,22 @@ static int cmListFileLexerInput(cmListFileLexer* lexer, char* buffer,
       }
       lexer->cr = cr;
       return n;
+    } else if (lexer->buffer) {
+      /* Convert CRLF -> LF while copying, as for files.  The buffer
+         holds the whole input so a CR can always see what follows.  */
+      char* o = buffer;
+      char* const oe = buffer + bufferSize;
+      const char* i = lexer->buffer;
+      const char* const ie = i + lexer->buffer_left;
+      while (o != oe && i != ie) {
+        if (i[0] == '\r' && i + 1 != ie && i[1] == '\n') {
+          ++i;
+        }
+        *o++ = *i++;
+      }
+      lexer->buffer_left -= (size_t)(i - lexer->buffer);
+      lexer->buffer = i;
+      return (int)(o - buffer);
     } else if (lexer->string_left) {
       int length = lexer->string_left;
       if ((int)bufferSize < length) {
@@ -2659,7 +2677,7 @@ static int cmListFileLexerInput(cmListFileLexer* lexer, char* buffer,
 /*--------------------------------------------------------------------------*/
 static void cmListFileLexerInit(cmListFileLexer* lexer)
 {
-  if (lexer->file || lexer->string_buffer) {
+  if (lexer->file || lexer->string_buffer || lexer->buffer) {
     cmListFileLexer_yylex_init(&lexer->scanner);
     cmListFileLexer_yyset_extra(lexer, lexer->scanner);
   }
@@ -2669,7 +2687,7 @@ static void cmListFileLexerInit(cmListFileLexer* lexer)
 static void cmListFileLexerDestroy(cmListFileLexer* lexer)
 {
   cmListFileLexerSetToken(lexer, 0, 0);
-  if (lexer->file || lexer->string_buffer) {
+  if (lexer->file || lexer->string_buffer || lexer->buffer) {
     cmListFileLexer_yylex_destroy(lexer->scanner);
     if (lexer->file) {
       fclose(lexer->file);
@@ -2681,6 +2699,8 @@ static void cmListFileLexerDestroy(cmListFileLexer* lexer)
       lexer->string_left = 0;
       lexer->string_position = 0;
     }
+    lexer->buffer = 0;
+    lexer->buffer_left = 0;
   }
 }
 
@@ -2784,10 +2804,43 @@ int cmListFileLexer_SetString(cmListFileLexer* lexer, const char* text)
   return result;
 }
 
+/*--------------------------------------------------------------------------*/
+int cmListFileLexer_SetBuffer(cmListFileLexer* lexer, const char* text,
+                              size_t length, cmListFileLexer_BOM* bom)
+{
+  const unsigned char* b = (const unsigned char*)text;
+  cmListFileLexerDestroy(lexer);
+  if (text) {
+    cmListFileLexer_BOM found = cmListFileLexer_BOM_None;
+    if (length >= 3 && b[0] == 0xEF && b[1] == 0xBB && b[2] == 0xBF) {
+      found = cmListFileLexer_BOM_UTF8;
+      text += 3;
+      length -= 3;
+    } else if (length >= 2 && b[0] == 0xFE && b[1] == 0xFF) {
+      found = cmListFileLexer_BOM_UTF16BE;
+    } else if (length >= 4 && b[0] == 0 && b[1] == 0 && b[2] == 0xFE &&
+               b[3] == 0xFF) {
+      found = cmListFileLexer_BOM_UTF32BE;
+    } else if (length >= 4 && b[0] == 0xFF && b[1] == 0xFE && b[2] == 0 &&
+               b[3] == 0) {
+      found = cmListFileLexer_BOM_UTF32LE;
+    } else if (length >= 2 && b[0] == 0xFF && b[1] == 0xFE) {
+      found = cmListFileLexer_BOM_UTF16LE;
+    }
+    if (bom) {
+      *bom = found;
+    }
+    lexer->buffer = text;
+    lexer->buffer_left = length;
+  }
+  cmListFileLexerInit(lexer);
+  return 1;
+}
+
 /*--------------------------------------------------------------------------*/
 cmListFileLexer_Token* cmListFileLexer_Scan(cmListFileLexer* lexer)
 {
-  if (!lexer->file && !lexer->string_buffer) {
+  if (!lexer->file && !lexer->string_buffer && !lexer->buffer) {
     return 0;
   }
   if (cmListFileLexer_yylex(lexer->scanner, lexer)) {
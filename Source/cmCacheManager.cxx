@@ -3,6 +3,7 @@
 #include "cmCacheManager.h"
 
 #include <algorithm>
+#include <cstdint>
 #include <cstdio>
 #include <cstring>
 #include <sstream>
@@ -11,6 +12,8 @@
 #include "cmsys/FStream.hxx"
 #include "cmsys/Glob.hxx"
 
+#include "cmCryptoHash.h"
+#include "cmFileTime.h"
 #include "cmGeneratedFileStream.h"
 #include "cmMessageType.h"
 #include "cmMessenger.h"
@@ -42,80 +45,74 @@ bool cmCacheManager::LoadCache(const std::string& path, bool internal,
     return false;
   }
 
-  cmsys::ifstream fin(cacheFile.c_str());
-  if (!fin) {
-    return false;
-  }
-  const char* realbuffer;
-  std::string buffer;
-  std::string entryKey;
-  unsigned int lineno = 0;
-  while (fin) {
-    // Format is key:type=value
-    std::string helpString;
-    CacheEntry e;
-    cmSystemTools::GetLineFromStream(fin, buffer);
-    lineno++;
-    realbuffer = buffer.c_str();
-    while (*realbuffer != '0' &&
-           (*realbuffer == ' ' || *realbuffer == '\t' || *realbuffer == '\r' ||
-            *realbuffer == '\n')) {
-      if (*realbuffer == '\n') {
-        lineno++;
-      }
-      realbuffer++;
+  // Use the binary copy of the cache if it was written for this content
+  // of the text file.  The text file is read and hashed only if its size
+  // or modification time changed since the copy was written.
+  std::string const sidecarFile = GetSidecarFile(path);
+  Sidecar sidecar;
+  bool const haveSidecar = ReadSidecar(sidecarFile, sidecar, true);
+  bool const sidecarCurrent =
+    haveSidecar && IsSidecarCurrent(sidecarFile, cacheFile, sidecar);
+  bool fromSidecar = sidecarCurrent;
+  bool parsed = true;
+  if (!sidecarCurrent) {
+    std::string content;
+    if (!ReadCacheFile(cacheFile, content)) {
+      return false;
     }
-    // skip blank lines and comment lines
-    if (realbuffer[0] == '#' || realbuffer[0] == 0) {
-      continue;
+    std::string const contentHash =
+      cmCryptoHash(cmCryptoHash::AlgoMD5).HashString(content);
+    fromSidecar = haveSidecar && sidecar.ContentHash == contentHash;
+    if (!fromSidecar) {
+      sidecar.ContentHash = contentHash;
+      sidecar.Records.clear();
+      parsed = ParseCacheFile(content, cacheFile, sidecar.Records);
     }
-    while (realbuffer[0] == '/' && realbuffer[1] == '/') {
-      if ((realbuffer[2] == '\\') && (realbuffer[3] == 'n')) {
-        helpString += '\n';
-        helpString += &realbuffer[4];
-      } else {
-        helpString += &realbuffer[2];
-      }
-      cmSystemTools::GetLineFromStream(fin, buffer);
-      lineno++;
-      realbuffer = buffer.c_str();
-      if (!fin) {
-        continue;
-      }
-    }
-    e.SetProperty("HELPSTRING", helpString.c_str());
-    if (cmState::ParseCacheEntry(realbuffer, entryKey, e.Value, e.Type)) {
-      if (excludes.find(entryKey) == excludes.end()) {
-        // Load internal values if internal is set.
-        // If the entry is not internal to the cache being loaded
-        // or if it is in the list of internal entries to be
-        // imported, load it.
-        if (internal || (e.Type != cmStateEnums::INTERNAL) ||
-            (includes.find(entryKey) != includes.end())) {
-          // If we are loading the cache from another project,
-          // make all loaded entries internal so that it is
-          // not visible in the gui
-          if (!internal) {
-            e.Type = cmStateEnums::INTERNAL;
-            helpString = cmStrCat("DO NOT EDIT, ", entryKey,
-                                  " loaded from external file.  "
-                                  "To change this value edit this file: ",
-                                  path, "/CMakeCache.txt");
-            e.SetProperty("HELPSTRING", helpString.c_str());
-          }
-          if (!this->ReadPropertyEntry(entryKey, e)) {
-            e.Initialized = true;
-            this->Cache[entryKey] = e;
-          }
+  }
+
+  for (Record const& r : sidecar.Records) {
+    CacheEntry e;
+    e.Type = r.Type;
+    e.Value = r.Value;
+    e.SetProperty("HELPSTRING", r.Help.c_str());
+    if (excludes.find(r.Key) == excludes.end()) {
+      // Load internal values if internal is set.
+      // If the entry is not internal to the cache being loaded
+      // or if it is in the list of internal entries to be
+      // imported, load it.
+      if (internal || (e.Type != cmStateEnums::INTERNAL) ||
+          (includes.find(r.Key) != includes.end())) {
+        // If we are loading the cache from another project,
+        // make all loaded entries internal so that it is
+        // not visible in the gui
+        if (!internal) {
+          e.Type = cmStateEnums::INTERNAL;
+          std::string helpString =
+            cmStrCat("DO NOT EDIT, ", r.Key,
+                     " loaded from external file.  "
+                     "To change this value edit this file: ",
+                     path, "/CMakeCache.txt");
+          e.SetProperty("HELPSTRING", helpString.c_str());
+        }
+        if (!this->ReadPropertyEntry(r.Key, e)) {
+          e.Initialized = true;
+          this->Cache[r.Key] = e;
         }
       }
-    } else {
-      std::ostringstream error;
-      error << "Parse error in cache file " << cacheFile << " on line "
-            << lineno << ". Offending entry: " << realbuffer;
-      cmSystemTools::Error(error.str());
     }
   }
+
+  if (fromSidecar) {
+    ++this->SidecarHits;
+  } else if (internal && this->IsSidecarEnabled()) {
+    ++this->SidecarMisses;
+  }
+  // Bring the binary copy up to date after the text file was edited or
+  // touched, so the next load does not read the text file again.
+  if (!sidecarCurrent && parsed && internal && this->IsSidecarEnabled()) {
+    WriteSidecar(sidecarFile, cacheFile, sidecar);
+  }
+
   this->CacheMajorVersion = 0;
   this->CacheMinorVersion = 0;
   if (cmProp cmajor =
@@ -165,6 +162,198 @@ bool cmCacheManager::LoadCache(const std::string& path, bool internal,
   return true;
 }
 
+bool cmCacheManager::ReadCacheFile(const std::string& cacheFile,
+                                   std::string& content)
+{
+  cmsys::ifstream fin(cacheFile.c_str(), std::ios::in | std::ios::binary);
+  if (!fin) {
+    return false;
+  }
+  std::ostringstream buffer;
+  buffer << fin.rdbuf();
+  content = buffer.str();
+  return true;
+}
+
+bool cmCacheManager::ParseCacheFile(const std::string& content,
+                                    const std::string& cacheFile,
+                                    std::vector<Record>& records)
+{
+  std::istringstream fin(content);
+  bool parsed = true;
+  const char* realbuffer;
+  std::string buffer;
+  unsigned int lineno = 0;
+  while (fin) {
+    // Format is key:type=value
+    Record r;
+    cmSystemTools::GetLineFromStream(fin, buffer);
+    lineno++;
+    realbuffer = buffer.c_str();
+    while (*realbuffer != '0' &&
+           (*realbuffer == ' ' || *realbuffer == '\t' || *realbuffer == '\r' ||
+            *realbuffer == '\n')) {
+      if (*realbuffer == '\n') {
+        lineno++;
+      }
+      realbuffer++;
+    }
+    // skip blank lines and comment lines
+    if (realbuffer[0] == '#' || realbuffer[0] == 0) {
+      continue;
+    }
+    while (realbuffer[0] == '/' && realbuffer[1] == '/') {
+      if ((realbuffer[2] == '\\') && (realbuffer[3] == 'n')) {
+        r.Help += '\n';
+        r.Help += &realbuffer[4];
+      } else {
+        r.Help += &realbuffer[2];
+      }
+      cmSystemTools::GetLineFromStream(fin, buffer);
+      lineno++;
+      realbuffer = buffer.c_str();
+      if (!fin) {
+        continue;
+      }
+    }
+    if (cmState::ParseCacheEntry(realbuffer, r.Key, r.Value, r.Type)) {
+      records.push_back(std::move(r));
+    } else {
+      std::ostringstream error;
+      error << "Parse error in cache file " << cacheFile << " on line "
+            << lineno << ". Offending entry: " << realbuffer;
+      cmSystemTools::Error(error.str());
+      parsed = false;
+    }
+  }
+  return parsed;
+}
+
+namespace {
+// The binary copy of the cache holds the entries as parsed from the text
+// file, so loading it has the same effect as parsing the text file.
+const char SidecarMagic[] = "CMakeCacheSidecar2";
+
+template <typename T>
+void WriteNumber(std::string& out, T value)
+{
+  out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template <typename T>
+bool ReadNumber(std::string const& in, std::string::size_type& pos, T& value)
+{
+  if (in.size() - pos < sizeof(value)) {
+    return false;
+  }
+  memcpy(&value, in.data() + pos, sizeof(value));
+  pos += sizeof(value);
+  return true;
+}
+
+void WriteString(std::string& out, std::string const& str)
+{
+  WriteNumber(out, static_cast<std::uint32_t>(str.size()));
+  out += str;
+}
+
+bool ReadString(std::string const& in, std::string::size_type& pos,
+                std::string& str)
+{
+  std::uint32_t size;
+  if (!ReadNumber(in, pos, size) || in.size() - pos < size) {
+    return false;
+  }
+  str.assign(in, pos, size);
+  pos += size;
+  return true;
+}
+}
+
+bool cmCacheManager::IsSidecarEnabled() const
+{
+  return cmIsOn(this->GetInitializedCacheValue("CMAKE_CACHE_SIDECAR"));
+}
+
+std::string cmCacheManager::GetSidecarFile(const std::string& path)
+{
+  return cmStrCat(path, "/CMakeFiles/CMakeCache.bin");
+}
+
+bool cmCacheManager::ReadSidecar(const std::string& sidecarFile,
+                                 Sidecar& sidecar, bool readRecords)
+{
+  std::string in;
+  if (!cmSystemTools::FileExists(sidecarFile, true) ||
+      !ReadCacheFile(sidecarFile, in)) {
+    return false;
+  }
+
+  std::string::size_type pos = 0;
+  std::string str;
+  if (!ReadString(in, pos, str) || str != SidecarMagic ||
+      !ReadNumber(in, pos, sidecar.Size) ||
+      !ReadNumber(in, pos, sidecar.MTime) ||
+      !ReadString(in, pos, sidecar.ContentHash)) {
+    return false;
+  }
+  if (!readRecords) {
+    return true;
+  }
+  while (pos < in.size()) {
+    Record r;
+    if (!ReadString(in, pos, r.Key) || !ReadString(in, pos, str) ||
+        !ReadString(in, pos, r.Value) || !ReadString(in, pos, r.Help) ||
+        !cmState::StringToCacheEntryType(str, r.Type)) {
+      return false;
+    }
+    sidecar.Records.push_back(std::move(r));
+  }
+  return true;
+}
+
+bool cmCacheManager::IsSidecarCurrent(const std::string& sidecarFile,
+                                      const std::string& cacheFile,
+                                      Sidecar const& sidecar)
+{
+  cmFileTime cacheTime;
+  cmFileTime sidecarTime;
+  if (!cacheTime.Load(cacheFile) || !sidecarTime.Load(sidecarFile)) {
+    return false;
+  }
+  // A text file written in the same clock tick as the copy may have
+  // changed afterwards without a change of its modification time.
+  return sidecar.Size == cmSystemTools::FileLength(cacheFile) &&
+    sidecar.MTime == cacheTime.GetNS() && cacheTime.Older(sidecarTime);
+}
+
+void cmCacheManager::WriteSidecar(const std::string& sidecarFile,
+                                  const std::string& cacheFile,
+                                  Sidecar& sidecar)
+{
+  cmFileTime cacheTime;
+  if (!cacheTime.Load(cacheFile)) {
+    return;
+  }
+  sidecar.Size = cmSystemTools::FileLength(cacheFile);
+  sidecar.MTime = cacheTime.GetNS();
+
+  std::string out;
+  WriteString(out, SidecarMagic);
+  WriteNumber(out, sidecar.Size);
+  WriteNumber(out, sidecar.MTime);
+  WriteString(out, sidecar.ContentHash);
+  for (Record const& r : sidecar.Records) {
+    WriteString(out, r.Key);
+    WriteString(out, cmState::CacheEntryTypeToString(r.Type));
+    WriteString(out, r.Value);
+    WriteString(out, r.Help);
+  }
+  // Always replace the file so that it is newer than the text file.
+  cmGeneratedFileStream fout(sidecarFile);
+  fout.write(out.data(), static_cast<std::streamsize>(out.size()));
+}
+
 const char* cmCacheManager::PersistentProperties[] = { "ADVANCED", "MODIFIED",
                                                        "STRINGS" };
 
@@ -338,6 +527,36 @@ bool cmCacheManager::SaveCache(const std::string& path, cmMessenger* messenger)
   }
   fout << '\n';
   fout.Close();
+
+  // Bring the binary copy up to date.  The text file is not replaced
+  // when its content did not change, so it is read and hashed again only
+  // after a change, and parsed again only if the content differs.
+  std::string const sidecarFile = GetSidecarFile(path);
+  if (!this->IsSidecarEnabled()) {
+    if (cmSystemTools::FileExists(sidecarFile)) {
+      cmSystemTools::RemoveFile(sidecarFile);
+    }
+  } else {
+    Sidecar sidecar;
+    bool const haveSidecar = ReadSidecar(sidecarFile, sidecar, false);
+    std::string content;
+    if (!(haveSidecar &&
+          IsSidecarCurrent(sidecarFile, cacheFile, sidecar)) &&
+        ReadCacheFile(cacheFile, content)) {
+      std::string const contentHash =
+        cmCryptoHash(cmCryptoHash::AlgoMD5).HashString(content);
+      bool updated = haveSidecar && sidecar.ContentHash == contentHash &&
+        ReadSidecar(sidecarFile, sidecar, true);
+      if (!updated) {
+        sidecar.ContentHash = contentHash;
+        sidecar.Records.clear();
+        updated = ParseCacheFile(content, cacheFile, sidecar.Records);
+      }
+      if (updated) {
+        WriteSidecar(sidecarFile, cacheFile, sidecar);
+      }
+    }
+  }
   std::string checkCacheFile = cmStrCat(path, "/CMakeFiles");
   cmSystemTools::MakeDirectory(checkCacheFile);
   checkCacheFile += "/cmake.check_cache";
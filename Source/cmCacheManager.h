@@ -168,6 +168,11 @@ public:
   unsigned int GetCacheMajorVersion() const { return this->CacheMajorVersion; }
   unsigned int GetCacheMinorVersion() const { return this->CacheMinorVersion; }
 
+  /** Count the loads of the build tree cache from its binary copy, and
+      those that parsed the text file although the copy is enabled.  */
+  unsigned long GetSidecarHits() const { return this->SidecarHits; }
+  unsigned long GetSidecarMisses() const { return this->SidecarMisses; }
+
   //! Add an entry into the cache
   void AddCacheEntry(const std::string& key, const char* value,
                      const char* helpString,
@@ -198,6 +203,41 @@ private:
   static void OutputValueNoNewlines(std::ostream& fout,
                                     std::string const& value);
 
+  //! An entry as written in the text file
+  struct Record
+  {
+    std::string Key;
+    cmStateEnums::CacheEntryType Type = cmStateEnums::UNINITIALIZED;
+    std::string Value;
+    std::string Help;
+  };
+  static bool ReadCacheFile(const std::string& cacheFile,
+                            std::string& content);
+  static bool ParseCacheFile(const std::string& content,
+                             const std::string& cacheFile,
+                             std::vector<Record>& records);
+
+  //! The binary copy of the text file, used for faster loading
+  struct Sidecar
+  {
+    // Size and modification time of the text file the copy was written
+    // for.  They identify the text file content without reading it.
+    unsigned long long Size = 0;
+    long long MTime = 0;
+    // Checked when the text file was touched or written again.
+    std::string ContentHash;
+    std::vector<Record> Records;
+  };
+  bool IsSidecarEnabled() const;
+  static std::string GetSidecarFile(const std::string& path);
+  static bool ReadSidecar(const std::string& sidecarFile, Sidecar& sidecar,
+                          bool readRecords);
+  static bool IsSidecarCurrent(const std::string& sidecarFile,
+                               const std::string& cacheFile,
+                               Sidecar const& sidecar);
+  static void WriteSidecar(const std::string& sidecarFile,
+                           const std::string& cacheFile, Sidecar& sidecar);
+
   static const char* PersistentProperties[];
   bool ReadPropertyEntry(const std::string& key, const CacheEntry& e);
   void WritePropertyEntries(std::ostream& os, const std::string& entryKey,
@@ -208,4 +248,7 @@ private:
   // Cache version info
   unsigned int CacheMajorVersion = 0;
   unsigned int CacheMinorVersion = 0;
+
+  unsigned long SidecarHits = 0;
+  unsigned long SidecarMisses = 0;
 };
@@ -7,6 +7,7 @@
 #include <cstdio>
 #include <iterator>
 #include <sstream>
+#include <tuple>
 #include <utility>
 
 #include <cm/memory>
@@ -210,6 +211,15 @@ void cmComputeLinkDepends::SetOldLinkDirMode(bool b)
 std::vector<cmComputeLinkDepends::LinkEntry> const&
 cmComputeLinkDepends::Compute()
 {
+  // Look for a result computed for another target linking the same items.
+  // Debug mode displays the intermediate steps so it always computes.
+  cmComputeLinkDependsCache* cache = this->DebugMode
+    ? nullptr
+    : this->GlobalGenerator->GetComputeLinkDependsCache();
+  if (cache && this->LoadCachedEntries(*cache)) {
+    return this->FinalLinkEntries;
+  }
+
   // Follow the link dependencies of the target to be linked.
   this->AddDirectLinkEntries();
 
@@ -254,6 +264,7 @@ cmComputeLinkDepends::Compute()
   // Iterate in reverse order so we can keep only the last occurrence
   // of a shared library.
   std::set<int> emitted;
+  std::vector<int> finalIndices;
   for (int i : cmReverseRange(this->FinalLinkOrder)) {
     LinkEntry const& e = this->EntryList[i];
     cmGeneratorTarget const* t = e.Target;
@@ -261,10 +272,16 @@ cmComputeLinkDepends::Compute()
     bool uniquify = t && t->GetType() == cmStateEnums::SHARED_LIBRARY;
     if (!uniquify || emitted.insert(i).second) {
       this->FinalLinkEntries.push_back(e);
+      finalIndices.push_back(i);
     }
   }
   // Reverse the resulting order since we iterated in reverse.
   std::reverse(this->FinalLinkEntries.begin(), this->FinalLinkEntries.end());
+  std::reverse(finalIndices.begin(), finalIndices.end());
+
+  if (cache && this->Cacheable) {
+    this->StoreCachedEntries(*cache, finalIndices);
+  }
 
   // Display the final set.
   if (this->DebugMode) {
@@ -274,6 +291,87 @@ cmComputeLinkDepends::Compute()
   return this->FinalLinkEntries;
 }
 
+namespace {
+cmComputeLinkDependsCache::Key MakeCacheKey(cmLinkImplementation const& impl,
+                                            std::string const& config,
+                                            bool oldLinkDirMode)
+{
+  cmComputeLinkDependsCache::Key key;
+  key.Config = config;
+  key.OldLinkDirMode = oldLinkDirMode;
+  key.Libraries.assign(impl.Libraries.begin(), impl.Libraries.end());
+  key.WrongConfigLibraries = impl.WrongConfigLibraries;
+  return key;
+}
+}
+
+bool cmComputeLinkDepends::LoadCachedEntries(cmComputeLinkDependsCache& cache)
+{
+  cmLinkImplementation const* impl =
+    this->Target->GetLinkImplementation(this->Config);
+  cmComputeLinkDependsCache::Result const* result =
+    cache.Find(MakeCacheKey(*impl, this->Config, this->OldLinkDirMode));
+
+  // The result is valid for this target only if the computation would
+  // not skip an item naming it, and would not find any of the old-style
+  // dependency variables in its directory.
+  if (!result ||
+      std::binary_search(result->Items.begin(), result->Items.end(),
+                         this->Target->GetName()) ||
+      std::any_of(result->UndefinedLibDepends.begin(),
+                  result->UndefinedLibDepends.end(),
+                  [this](std::string const& var) {
+                    return this->Makefile->GetDefinition(var) != nullptr;
+                  })) {
+    cache.CountMiss();
+    return false;
+  }
+  cache.CountHit();
+
+  // Entries for direct link items carry the backtraces of this target.
+  std::vector<cmLinkImplItem const*> direct;
+  for (cmLinkImplItem const& item : impl->Libraries) {
+    if (!item.AsStr().empty()) {
+      direct.push_back(&item);
+    }
+  }
+  this->FinalLinkEntries = result->Entries;
+  for (std::size_t i = 0; i < this->FinalLinkEntries.size(); ++i) {
+    int d = result->DirectIndices[i];
+    if (d >= 0) {
+      this->FinalLinkEntries[i].Item.Backtrace = direct[d]->Backtrace;
+    }
+  }
+  this->OldWrongConfigItems = result->OldWrongConfigItems;
+  return true;
+}
+
+void cmComputeLinkDepends::StoreCachedEntries(
+  cmComputeLinkDependsCache& cache, std::vector<int> const& finalIndices)
+{
+  cmComputeLinkDependsCache::Result result;
+  result.Entries = this->FinalLinkEntries;
+  for (int i : finalIndices) {
+    auto oi = std::find(this->OriginalEntries.begin(),
+                        this->OriginalEntries.end(), i);
+    result.DirectIndices.push_back(
+      oi == this->OriginalEntries.end()
+        ? -1
+        : static_cast<int>(oi - this->OriginalEntries.begin()));
+  }
+  result.OldWrongConfigItems = this->OldWrongConfigItems;
+  for (LinkEntry const& e : this->EntryList) {
+    result.Items.push_back(e.Item.Value);
+  }
+  std::sort(result.Items.begin(), result.Items.end());
+  result.UndefinedLibDepends = this->UndefinedLibDepends;
+
+  cmLinkImplementation const* impl =
+    this->Target->GetLinkImplementation(this->Config);
+  cache.Store(MakeCacheKey(*impl, this->Config, this->OldLinkDirMode),
+              std::move(result));
+}
+
 std::map<cmLinkItem, int>::iterator cmComputeLinkDepends::AllocateLinkEntry(
   cmLinkItem const& item)
 {
@@ -319,9 +417,15 @@ int cmComputeLinkDepends::AddLinkEntry(cmLinkItem const& item)
       // The item dependencies are known.  Follow them.
       BFSEntry qe = { index, val->c_str() };
       this->BFSQueue.push(qe);
-    } else if (!entry.IsFlag) {
-      // The item dependencies are not known.  We need to infer them.
-      this->InferredDependSets[index].Initialized = true;
+      // The variable is looked up in the directory of the target being
+      // linked and the items it names are resolved in its scope.
+      this->Cacheable = false;
+    } else {
+      this->UndefinedLibDepends.push_back(std::move(var));
+      if (!entry.IsFlag) {
+        // The item dependencies are not known.  We need to infer them.
+        this->InferredDependSets[index].Initialized = true;
+      }
     }
   }
 
@@ -339,6 +443,7 @@ void cmComputeLinkDepends::FollowLinkEntry(BFSEntry qe)
     // Follow the target dependencies.
     if (cmLinkInterface const* iface =
           entry.Target->GetLinkInterface(this->Config, this->Target)) {
+      this->CheckCacheable(iface);
       const bool isIface =
         entry.Target->GetType() == cmStateEnums::INTERFACE_LIBRARY;
       // This target provides its own link interface information.
@@ -418,6 +523,7 @@ void cmComputeLinkDepends::HandleSharedDependency(SharedDepEntry const& dep)
   if (entry.Target) {
     if (cmLinkInterface const* iface =
           entry.Target->GetLinkInterface(this->Config, this->Target)) {
+      this->CheckCacheable(iface);
       // Follow public and private dependencies transitively.
       this->FollowSharedDeps(index, iface, true);
     }
@@ -504,7 +610,11 @@ void cmComputeLinkDepends::AddLinkEntries(int depender_index,
     // Skip entries that will resolve to the target getting linked or
     // are empty.
     cmLinkItem const& item = l;
-    if (item.AsStr() == this->Target->GetName() || item.AsStr().empty()) {
+    if (item.AsStr() == this->Target->GetName()) {
+      this->Cacheable = false;
+      continue;
+    }
+    if (item.AsStr().empty()) {
       continue;
     }
 
@@ -827,6 +937,16 @@ void cmComputeLinkDepends::DisplayFinalEntries()
   fprintf(stderr, "\n");
 }
 
+void cmComputeLinkDepends::CheckCacheable(cmLinkInterface const* iface)
+{
+  // An interface evaluated for the target being linked, or for its link
+  // language, may not be the one another target sees.
+  if (iface->HadHeadSensitiveCondition ||
+      iface->HadLinkLanguageSensitiveCondition) {
+    this->Cacheable = false;
+  }
+}
+
 void cmComputeLinkDepends::CheckWrongConfigItem(cmLinkItem const& item)
 {
   if (!this->OldLinkDirMode) {
@@ -840,3 +960,23 @@ void cmComputeLinkDepends::CheckWrongConfigItem(cmLinkItem const& item)
     this->OldWrongConfigItems.insert(item.Target);
   }
 }
+
+bool cmComputeLinkDependsCache::Key::operator<(Key const& other) const
+{
+  return std::tie(this->Config, this->OldLinkDirMode, this->Libraries,
+                  this->WrongConfigLibraries) <
+    std::tie(other.Config, other.OldLinkDirMode, other.Libraries,
+             other.WrongConfigLibraries);
+}
+
+cmComputeLinkDependsCache::Result const* cmComputeLinkDependsCache::Find(
+  Key const& key) const
+{
+  auto it = this->Results.find(key);
+  return it != this->Results.end() ? &it->second : nullptr;
+}
+
+void cmComputeLinkDependsCache::Store(Key key, Result result)
+{
+  this->Results.emplace(std::move(key), std::move(result));
+}
@@ -4,6 +4,7 @@
 
 #include "cmConfigure.h" // IWYU pragma: keep
 
+#include <cstddef>
 #include <map>
 #include <memory>
 #include <queue>
@@ -17,6 +18,7 @@
 #include "cmTargetLinkLibraryType.h"
 
 class cmComputeComponentGraph;
+class cmComputeLinkDependsCache;
 class cmGeneratorTarget;
 class cmGlobalGenerator;
 class cmMakefile;
@@ -62,6 +64,15 @@ private:
   std::string Config;
   EntryVector FinalLinkEntries;
 
+  // Reuse of results computed for other targets with the same direct
+  // link items.
+  bool LoadCachedEntries(cmComputeLinkDependsCache& cache);
+  void StoreCachedEntries(cmComputeLinkDependsCache& cache,
+                          std::vector<int> const& finalIndices);
+  void CheckCacheable(cmLinkInterface const* iface);
+  bool Cacheable = true;
+  std::vector<std::string> UndefinedLibDepends;
+
   std::map<cmLinkItem, int>::iterator AllocateLinkEntry(
     cmLinkItem const& item);
   int AddLinkEntry(cmLinkItem const& item);
@@ -159,3 +170,55 @@ private:
   bool DebugMode;
   bool OldLinkDirMode;
 };
+
+/** \class cmComputeLinkDependsCache
+ * \brief Share computed link dependencies between targets.
+ *
+ * Targets that link the same items directly usually get the same final
+ * link entries.  Results are keyed on the direct link items, and are
+ * stored only when no part of the computation observed the target being
+ * linked, e.g. through a link interface with $<TARGET_PROPERTY:prop>.
+ *
+ * The link information built from these entries is not shared.  It
+ * depends on the target itself: its linker language, the link flags and
+ * policies of its directory, its LINK_SEARCH_*_STATIC properties and the
+ * runtime search path, and it issues per-target diagnostics.
+ */
+class cmComputeLinkDependsCache
+{
+public:
+  struct Key
+  {
+    std::string Config;
+    bool OldLinkDirMode;
+    std::vector<cmLinkItem> Libraries;
+    std::vector<cmLinkItem> WrongConfigLibraries;
+
+    bool operator<(Key const& other) const;
+  };
+
+  struct Result
+  {
+    cmComputeLinkDepends::EntryVector Entries;
+    // Index of the direct link item that produced each entry, or -1.
+    std::vector<int> DirectIndices;
+    std::set<cmGeneratorTarget const*> OldWrongConfigItems;
+    // Names of all items considered, sorted.
+    std::vector<std::string> Items;
+    // The <item>_LIB_DEPENDS variables found to be undefined.
+    std::vector<std::string> UndefinedLibDepends;
+  };
+
+  Result const* Find(Key const& key) const;
+  void Store(Key key, Result result);
+
+  void CountHit() { ++this->Hits; }
+  void CountMiss() { ++this->Misses; }
+  std::size_t GetHits() const { return this->Hits; }
+  std::size_t GetMisses() const { return this->Misses; }
+
+private:
+  std::map<Key, Result> Results;
+  std::size_t Hits = 0;
+  std::size_t Misses = 0;
+};
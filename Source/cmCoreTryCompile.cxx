@@ -2,17 +2,24 @@
    file Copyright.txt or https://cmake.org/licensing for details.  */
 #include "cmCoreTryCompile.h"
 
+#include <algorithm>
+#include <array>
 #include <cstdio>
+#include <cstdlib>
 #include <cstring>
 #include <set>
 #include <sstream>
+#include <thread>
 #include <utility>
 
 #include <cmext/string_view>
 
 #include "cmsys/Directory.hxx"
+#include "cmsys/FStream.hxx"
 
+#include "cmCryptoHash.h"
 #include "cmExportTryCompileFileGenerator.h"
+#include "cmGeneratedFileStream.h"
 #include "cmGlobalGenerator.h"
 #include "cmMakefile.h"
 #include "cmMessageType.h"
@@ -222,12 +229,157 @@ std::string const kCMAKE_TRY_COMPILE_PLATFORM_VARIABLES =
   "CMAKE_TRY_COMPILE_PLATFORM_VARIABLES";
 std::string const kCMAKE_WARN_DEPRECATED = "CMAKE_WARN_DEPRECATED";
 
+/* A test target of the generated project along with the variable
+   receiving its result.  */
+struct TryCompileProbe
+{
+  std::string ResultVariable;
+  std::string TargetName;
+  std::vector<std::string> Sources;
+  std::vector<std::string> CompileDefs;
+  std::vector<std::string> LinkOptions;
+  std::string LibsToLink = " ";
+  bool UseOldLinkLibs = true;
+};
+
 /* GHS Multi platform variables */
 std::set<std::string> const ghs_platform_vars{
   "GHS_TARGET_PLATFORM", "GHS_PRIMARY_TARGET", "GHS_TOOLSET_ROOT",
   "GHS_OS_ROOT",         "GHS_OS_DIR",         "GHS_BSP_NAME",
   "GHS_OS_DIR_OPTION"
 };
+
+/* Compute the path at which the result of a source file signature
+   try_compile is stored in the CMAKE_TRY_COMPILE_CACHE_DIR.  The key
+   covers everything that can influence the result: the generated test
+   project (with its random target name and binary directory removed),
+   the content of each source, the variables forwarded to the inner
+   project, the compiler identity, the toolchain file and the generator.  */
+std::string ComputeResultCacheFile(
+  cmMakefile* mf, std::string const& cacheDir, std::string const& binDir,
+  std::string const& listFile, std::string const& targetName,
+  std::vector<std::string> const& sources,
+  std::vector<std::string> const& cmakeFlags,
+  std::set<std::string> const& langs, cmStateEnums::TargetType targetType)
+{
+  cmsys::ifstream fin(listFile.c_str(), std::ios::in | std::ios::binary);
+  if (!fin) {
+    return std::string();
+  }
+  std::ostringstream listContent;
+  listContent << fin.rdbuf();
+  std::string project = listContent.str();
+  cmSystemTools::ReplaceString(project, binDir, "<BINARY_DIR>");
+  cmSystemTools::ReplaceString(project, targetName, "<TARGET>");
+
+  cmCryptoHash hasher(cmCryptoHash::AlgoSHA256);
+  hasher.Initialize();
+  auto append = [&hasher](cm::string_view value) {
+    hasher.Append(value);
+    hasher.Append("\n", 1);
+  };
+
+  append(cmVersion::GetCMakeVersion());
+  append(mf->GetGlobalGenerator()->GetName());
+  append(mf->GetSafeDefinition("CMAKE_GENERATOR_PLATFORM"));
+  append(mf->GetSafeDefinition("CMAKE_GENERATOR_TOOLSET"));
+  append(cmState::GetTargetTypeName(targetType));
+  append(project);
+
+  for (std::string const& si : sources) {
+    std::string const hash =
+      cmCryptoHash(cmCryptoHash::AlgoSHA256).HashFile(si);
+    if (hash.empty()) {
+      return std::string();
+    }
+    append(cmSystemTools::GetFilenameName(si));
+    append(hash);
+  }
+
+  for (std::string const& flag : cmakeFlags) {
+    std::string value = flag;
+    cmSystemTools::ReplaceString(value, binDir, "<BINARY_DIR>");
+    append(value);
+  }
+
+  static std::array<std::string, 6> const compilerVars{ {
+    "COMPILER", "COMPILER_ARG1", "COMPILER_ID", "COMPILER_VERSION",
+    "COMPILER_TARGET", "COMPILER_EXTERNAL_TOOLCHAIN" } };
+  for (std::string const& li : langs) {
+    for (std::string const& var : compilerVars) {
+      append(mf->GetSafeDefinition(cmStrCat("CMAKE_", li, '_', var)));
+    }
+  }
+
+  std::string const& toolchain =
+    mf->GetSafeDefinition("CMAKE_TOOLCHAIN_FILE");
+  append(toolchain);
+  if (!toolchain.empty()) {
+    append(cmCryptoHash(cmCryptoHash::AlgoSHA256).HashFile(toolchain));
+  }
+
+  return cmStrCat(cacheDir, '/', hasher.FinalizeHex(), ".txt");
+}
+
+void WriteCompileDefinitions(FILE* fout,
+                             std::vector<std::string> const& compileDefs)
+{
+  if (!compileDefs.empty()) {
+    // Pass using bracket arguments to preserve content.
+    fprintf(fout, "add_definitions([==[%s]==])\n",
+            cmJoin(compileDefs, "]==] [==[").c_str());
+  }
+}
+
+bool ReadCachedResult(std::string const& cacheFile, int& res,
+                      std::string& output)
+{
+  cmsys::ifstream fin(cacheFile.c_str(), std::ios::in | std::ios::binary);
+  if (!fin) {
+    return false;
+  }
+  std::string line;
+  if (!cmSystemTools::GetLineFromStream(fin, line) ||
+      !cmHasLiteralPrefix(line, "result=")) {
+    return false;
+  }
+  res = atoi(line.c_str() + 7);
+  std::ostringstream content;
+  if (fin.peek() != EOF) {
+    content << fin.rdbuf();
+  }
+  output = content.str();
+  return true;
+}
+
+void WriteCachedResult(std::string const& cacheFile, int res,
+                       std::string const& output)
+{
+  cmSystemTools::MakeDirectory(cmSystemTools::GetFilenamePath(cacheFile));
+  // The content is written to a temporary file and renamed into place
+  // so that build trees sharing the cache never see a partial entry.
+  cmGeneratedFileStream fout(cacheFile);
+  fout.SetCopyIfDifferent(true);
+  fout << "result=" << res << "\n" << output;
+}
+
+int GetProbeBuildJobs(size_t probes)
+{
+  if (probes <= 1) {
+    return cmake::NO_BUILD_PARALLEL_LEVEL;
+  }
+  // Do not run more jobs than a parallel build would.
+  unsigned long limit = 0;
+  std::string parallel;
+  if (!cmSystemTools::GetEnv("CMAKE_BUILD_PARALLEL_LEVEL", parallel) ||
+      !cmStrToULong(parallel, &limit) || limit == 0) {
+    limit = std::thread::hardware_concurrency();
+  }
+  if (limit <= 1) {
+    return cmake::NO_BUILD_PARALLEL_LEVEL;
+  }
+  return static_cast<int>(std::min<unsigned long>(probes, limit));
+}
 }
 
 int cmCoreTryCompile::TryCompileCode(std::vector<std::string> const& argv,
@@ -263,7 +415,6 @@ int cmCoreTryCompile::TryCompileCode(std::vector<std::string> const& argv,
   std::string projectName;
   std::string targetName;
   std::vector<std::string> cmakeFlags(1, "CMAKE_FLAGS"); // fake argv[0]
-  std::vector<std::string> compileDefs;
   std::string cmakeInternal;
   std::string outputVariable;
   std::string copyFile;
@@ -274,15 +425,15 @@ int cmCoreTryCompile::TryCompileCode(std::vector<std::string> const& argv,
   LanguageStandardState objcState("OBJC");
   LanguageStandardState objcxxState("OBJCXX");
   std::vector<std::string> targets;
-  std::vector<std::string> linkOptions;
-  std::string libsToLink = " ";
-  bool useOldLinkLibs = true;
   char targetNameBuf[64];
   bool didOutputVariable = false;
   bool didCopyFile = false;
   bool didCopyFileError = false;
   bool useSources = argv[2] == "SOURCES";
-  std::vector<std::string> sources;
+  std::vector<TryCompileProbe> probes(1);
+  probes.front().ResultVariable = argv[0];
+  TryCompileProbe* probe = &probes.front();
+  std::string resultCacheFile;
 
   enum Doing
   {
@@ -295,6 +446,7 @@ int cmCoreTryCompile::TryCompileCode(std::vector<std::string> const& argv,
     DoingCopyFile,
     DoingCopyFileError,
     DoingSources,
+    DoingProbe,
     DoingCMakeInternal
   };
   Doing doing = useSources ? DoingSources : DoingNone;
@@ -307,10 +459,14 @@ int cmCoreTryCompile::TryCompileCode(std::vector<std::string> const& argv,
       doing = DoingLinkOptions;
     } else if (argv[i] == "LINK_LIBRARIES") {
       doing = DoingLinkLibraries;
-      useOldLinkLibs = false;
+      probe->UseOldLinkLibs = false;
     } else if (argv[i] == "OUTPUT_VARIABLE") {
       doing = DoingOutputVariable;
       didOutputVariable = true;
+    } else if (argv[i] == "PROBE") {
+      doing = DoingProbe;
+    } else if (argv[i] == "SOURCES" && probes.size() > 1) {
+      doing = DoingSources;
     } else if (argv[i] == "COPY_FILE") {
       doing = DoingCopyFile;
       didCopyFile = true;
@@ -328,11 +484,11 @@ int cmCoreTryCompile::TryCompileCode(std::vector<std::string> const& argv,
     } else if (doing == DoingCMakeFlags) {
       cmakeFlags.push_back(argv[i]);
     } else if (doing == DoingCompileDefinitions) {
-      cmExpandList(argv[i], compileDefs);
+      cmExpandList(argv[i], probe->CompileDefs);
     } else if (doing == DoingLinkOptions) {
-      linkOptions.push_back(argv[i]);
+      probe->LinkOptions.push_back(argv[i]);
     } else if (doing == DoingLinkLibraries) {
-      libsToLink += "\"" + cmTrimWhitespace(argv[i]) + "\" ";
+      probe->LibsToLink += "\"" + cmTrimWhitespace(argv[i]) + "\" ";
       if (cmTarget* tgt = this->Makefile->FindTargetToUse(argv[i])) {
         switch (tgt->GetType()) {
           case cmStateEnums::SHARED_LIBRARY:
@@ -368,7 +524,12 @@ int cmCoreTryCompile::TryCompileCode(std::vector<std::string> const& argv,
       copyFileError = argv[i];
       doing = DoingNone;
     } else if (doing == DoingSources) {
-      sources.push_back(argv[i]);
+      probe->Sources.push_back(argv[i]);
+    } else if (doing == DoingProbe) {
+      probes.emplace_back();
+      probe = &probes.back();
+      probe->ResultVariable = argv[i];
+      doing = DoingNone;
     } else if (doing == DoingCMakeInternal) {
       cmakeInternal = argv[i];
       doing = DoingNone;
@@ -411,13 +572,32 @@ int cmCoreTryCompile::TryCompileCode(std::vector<std::string> const& argv,
     return -1;
   }
 
-  if (useSources && sources.empty()) {
+  if (useSources && probes.front().Sources.empty()) {
     this->Makefile->IssueMessage(
       MessageType::FATAL_ERROR,
       "SOURCES must be followed by at least one source file");
     return -1;
   }
 
+  if (probes.size() > 1) {
+    if (isTryRun || !this->SrcFileSignature || didCopyFile) {
+      this->Makefile->IssueMessage(
+        MessageType::FATAL_ERROR,
+        "PROBE may be used only with the source file signature of "
+        "try_compile and without COPY_FILE");
+      return -1;
+    }
+    for (auto pi = probes.begin() + 1; pi != probes.end(); ++pi) {
+      if (pi->ResultVariable.empty() || pi->Sources.empty()) {
+        this->Makefile->IssueMessage(
+          MessageType::FATAL_ERROR,
+          "PROBE must be followed by a variable name, SOURCES and at least "
+          "one source file");
+        return -1;
+      }
+    }
+  }
+
   if (!this->SrcFileSignature) {
     if (!cState.Validate(this->Makefile)) {
       return -1;
@@ -442,7 +622,7 @@ int cmCoreTryCompile::TryCompileCode(std::vector<std::string> const& argv,
     this->BinaryDirectory += "/CMakeFiles/CMakeTmp";
   } else {
     // only valid for srcfile signatures
-    if (!compileDefs.empty()) {
+    if (!probes.front().CompileDefs.empty()) {
       this->Makefile->IssueMessage(
         MessageType::FATAL_ERROR,
         "COMPILE_DEFINITIONS specified on a srcdir type TRY_COMPILE");
@@ -476,29 +656,31 @@ int cmCoreTryCompile::TryCompileCode(std::vector<std::string> const& argv,
 
     // Choose sources.
     if (!useSources) {
-      sources.push_back(argv[2]);
+      probes.front().Sources.push_back(argv[2]);
     }
 
     // Detect languages to enable.
     cmGlobalGenerator* gg = this->Makefile->GetGlobalGenerator();
     std::set<std::string> testLangs;
-    for (std::string const& si : sources) {
-      std::string ext = cmSystemTools::GetFilenameLastExtension(si);
-      std::string lang = gg->GetLanguageFromExtension(ext.c_str());
-      if (!lang.empty()) {
-        testLangs.insert(lang);
-      } else {
-        std::ostringstream err;
-        err << "Unknown extension \"" << ext << "\" for file\n"
-            << "  " << si << "\n"
-            << "try_compile() works only for enabled languages.  "
-            << "Currently these are:\n  ";
-        std::vector<std::string> langs;
-        gg->GetEnabledLanguages(langs);
-        err << cmJoin(langs, " ");
-        err << "\nSee project() command to enable other languages.";
-        this->Makefile->IssueMessage(MessageType::FATAL_ERROR, err.str());
-        return -1;
+    for (TryCompileProbe const& p : probes) {
+      for (std::string const& si : p.Sources) {
+        std::string ext = cmSystemTools::GetFilenameLastExtension(si);
+        std::string lang = gg->GetLanguageFromExtension(ext.c_str());
+        if (!lang.empty()) {
+          testLangs.insert(lang);
+        } else {
+          std::ostringstream err;
+          err << "Unknown extension \"" << ext << "\" for file\n"
+              << "  " << si << "\n"
+              << "try_compile() works only for enabled languages.  "
+              << "Currently these are:\n  ";
+          std::vector<std::string> langs;
+          gg->GetEnabledLanguages(langs);
+          err << cmJoin(langs, " ");
+          err << "\nSee project() command to enable other languages.";
+          this->Makefile->IssueMessage(MessageType::FATAL_ERROR, err.str());
+          return -1;
+        }
       }
     }
 
@@ -665,16 +847,21 @@ int cmCoreTryCompile::TryCompileCode(std::vector<std::string> const& argv,
     fprintf(fout, "set(CMAKE_SUPPRESS_REGENERATION 1)\n");
     fprintf(fout, "link_directories(${LINK_DIRECTORIES})\n");
     // handle any compile flags we need to pass on
-    if (!compileDefs.empty()) {
-      // Pass using bracket arguments to preserve content.
-      fprintf(fout, "add_definitions([==[%s]==])\n",
-              cmJoin(compileDefs, "]==] [==[").c_str());
+    if (probes.size() == 1) {
+      WriteCompileDefinitions(fout, probes.front().CompileDefs);
     }
 
     /* Use a random file name to avoid rapid creation and deletion
        of the same executable name (some filesystems fail on that).  */
-    sprintf(targetNameBuf, "cmTC_%05x", cmSystemTools::RandomSeed() & 0xFFFFF);
-    targetName = targetNameBuf;
+    std::set<std::string> targetNames;
+    for (TryCompileProbe& p : probes) {
+      do {
+        sprintf(targetNameBuf, "cmTC_%05x",
+                cmSystemTools::RandomSeed() & 0xFFFFF);
+      } while (!targetNames.insert(targetNameBuf).second);
+      p.TargetName = targetNameBuf;
+    }
+    targetName = probes.front().TargetName;
 
     if (!targets.empty()) {
       std::string fname = "/" + std::string(targetName) + "Targets.cmake";
@@ -797,30 +984,6 @@ int cmCoreTryCompile::TryCompileCode(std::vector<std::string> const& argv,
               ? "NEW"
               : "OLD");
 
-    if (targetType == cmStateEnums::EXECUTABLE) {
-      /* Put the executable at a known location (for COPY_FILE).  */
-      fprintf(fout, "set(CMAKE_RUNTIME_OUTPUT_DIRECTORY \"%s\")\n",
-              this->BinaryDirectory.c_str());
-      /* Create the actual executable.  */
-      fprintf(fout, "add_executable(%s", targetName.c_str());
-    } else // if (targetType == cmStateEnums::STATIC_LIBRARY)
-    {
-      /* Put the static library at a known location (for COPY_FILE).  */
-      fprintf(fout, "set(CMAKE_ARCHIVE_OUTPUT_DIRECTORY \"%s\")\n",
-              this->BinaryDirectory.c_str());
-      /* Create the actual static library.  */
-      fprintf(fout, "add_library(%s STATIC", targetName.c_str());
-    }
-    for (std::string const& si : sources) {
-      fprintf(fout, " \"%s\"", si.c_str());
-
-      // Add dependencies on any non-temporary sources.
-      if (si.find("CMakeTmp") == std::string::npos) {
-        this->Makefile->AddCMakeDependFile(si);
-      }
-    }
-    fprintf(fout, ")\n");
-
     cState.Enabled(testLangs.find("C") != testLangs.end());
     cxxState.Enabled(testLangs.find("CXX") != testLangs.end());
     cudaState.Enabled(testLangs.find("CUDA") != testLangs.end());
@@ -880,38 +1043,113 @@ int cmCoreTryCompile::TryCompileCode(std::vector<std::string> const& argv,
       this->Makefile->IssueMessage(MessageType::AUTHOR_WARNING, w.str());
     }
 
-    cState.WriteProperties(fout, targetName);
-    cxxState.WriteProperties(fout, targetName);
-    cudaState.WriteProperties(fout, targetName);
-    objcState.WriteProperties(fout, targetName);
-    objcxxState.WriteProperties(fout, targetName);
-
-    if (!linkOptions.empty()) {
-      std::vector<std::string> options;
-      options.reserve(linkOptions.size());
-      for (const auto& option : linkOptions) {
-        options.emplace_back(cmOutputConverter::EscapeForCMake(option));
+    auto writeTarget = [&](FILE* out, TryCompileProbe const& p) {
+      char const* name = p.TargetName.c_str();
+      if (targetType == cmStateEnums::EXECUTABLE) {
+        /* Create the actual executable.  */
+        fprintf(out, "add_executable(%s", name);
+      } else // if (targetType == cmStateEnums::STATIC_LIBRARY)
+      {
+        /* Create the actual static library.  */
+        fprintf(out, "add_library(%s STATIC", name);
       }
+      for (std::string const& si : p.Sources) {
+        fprintf(out, " \"%s\"", si.c_str());
 
-      if (targetType == cmStateEnums::STATIC_LIBRARY) {
-        fprintf(fout,
-                "set_property(TARGET %s PROPERTY STATIC_LIBRARY_OPTIONS %s)\n",
-                targetName.c_str(), cmJoin(options, " ").c_str());
+        // Add dependencies on any non-temporary sources.
+        if (si.find("CMakeTmp") == std::string::npos) {
+          this->Makefile->AddCMakeDependFile(si);
+        }
+      }
+      fprintf(out, ")\n");
+
+      cState.WriteProperties(out, p.TargetName);
+      cxxState.WriteProperties(out, p.TargetName);
+      cudaState.WriteProperties(out, p.TargetName);
+      objcState.WriteProperties(out, p.TargetName);
+      objcxxState.WriteProperties(out, p.TargetName);
+
+      if (!p.LinkOptions.empty()) {
+        std::vector<std::string> options;
+        options.reserve(p.LinkOptions.size());
+        for (const auto& option : p.LinkOptions) {
+          options.emplace_back(cmOutputConverter::EscapeForCMake(option));
+        }
+
+        if (targetType == cmStateEnums::STATIC_LIBRARY) {
+          fprintf(out,
+                  "set_property(TARGET %s PROPERTY STATIC_LIBRARY_OPTIONS "
+                  "%s)\n",
+                  name, cmJoin(options, " ").c_str());
+        } else {
+          fprintf(out, "target_link_options(%s PRIVATE %s)\n", name,
+                  cmJoin(options, " ").c_str());
+        }
+      }
+
+      if (p.UseOldLinkLibs) {
+        fprintf(out, "target_link_libraries(%s ${LINK_LIBRARIES})\n", name);
       } else {
-        fprintf(fout, "target_link_options(%s PRIVATE %s)\n",
-                targetName.c_str(), cmJoin(options, " ").c_str());
+        fprintf(out, "target_link_libraries(%s %s)\n", name,
+                p.LibsToLink.c_str());
       }
-    }
+    };
 
-    if (useOldLinkLibs) {
-      fprintf(fout, "target_link_libraries(%s ${LINK_LIBRARIES})\n",
-              targetName.c_str());
+    if (targetType == cmStateEnums::EXECUTABLE) {
+      /* Put the executable at a known location (for COPY_FILE).  */
+      fprintf(fout, "set(CMAKE_RUNTIME_OUTPUT_DIRECTORY \"%s\")\n",
+              this->BinaryDirectory.c_str());
+    } else // if (targetType == cmStateEnums::STATIC_LIBRARY)
+    {
+      /* Put the static library at a known location (for COPY_FILE).  */
+      fprintf(fout, "set(CMAKE_ARCHIVE_OUTPUT_DIRECTORY \"%s\")\n",
+              this->BinaryDirectory.c_str());
+    }
+    if (probes.size() == 1) {
+      writeTarget(fout, probes.front());
     } else {
-      fprintf(fout, "target_link_libraries(%s %s)\n", targetName.c_str(),
-              libsToLink.c_str());
+      /* Give each probe a directory of its own so that its compile
+         definitions do not reach the other test targets.  */
+      for (size_t pi = 0; pi < probes.size(); ++pi) {
+        TryCompileProbe const& p = probes[pi];
+        std::string const probeSubdir = cmStrCat("probe", pi);
+        std::string const probeDir =
+          cmStrCat(this->BinaryDirectory, '/', probeSubdir);
+        cmSystemTools::MakeDirectory(probeDir);
+        std::string const probeFile = probeDir + "/CMakeLists.txt";
+        FILE* pout = cmsys::SystemTools::Fopen(probeFile, "w");
+        if (!pout) {
+          std::ostringstream e;
+          /* clang-format off */
+          e << "Failed to open\n"
+            << "  " << probeFile << "\n"
+            << cmSystemTools::GetLastSystemError();
+          /* clang-format on */
+          this->Makefile->IssueMessage(MessageType::FATAL_ERROR, e.str());
+          fclose(fout);
+          return -1;
+        }
+        WriteCompileDefinitions(pout, p.CompileDefs);
+        writeTarget(pout, p);
+        fclose(pout);
+        fprintf(fout, "add_subdirectory(%s)\n", probeSubdir.c_str());
+      }
     }
     fclose(fout);
     projectName = "CMAKE_TRY_COMPILE";
+
+    // Results of checks that produce no file used by the caller may be
+    // shared with other build trees through a persistent cache.
+    cmProp cacheDir =
+      this->Makefile->GetDefinition("CMAKE_TRY_COMPILE_CACHE_DIR");
+    if (cmNonempty(cacheDir) && !isTryRun && copyFile.empty() &&
+        targets.empty() && probes.size() == 1 &&
+        !this->Makefile->GetCMakeInstance()->GetDebugTryCompile()) {
+      resultCacheFile = ComputeResultCacheFile(
+        this->Makefile, *cacheDir, this->BinaryDirectory, outFileName,
+        targetName, probes.front().Sources, cmakeFlags, testLangs,
+        targetType);
+    }
   }
 
   if (this->Makefile->GetState()->UseGhsMultiIDE()) {
@@ -924,22 +1162,66 @@ int cmCoreTryCompile::TryCompileCode(std::vector<std::string> const& argv,
     }
   }
 
-  bool erroroc = cmSystemTools::GetErrorOccuredFlag();
-  cmSystemTools::ResetErrorOccuredFlag();
+  int res = -1;
   std::string output;
-  // actually do the try compile now that everything is setup
-  int res = this->Makefile->TryCompile(
-    sourceDirectory, this->BinaryDirectory, projectName, targetName,
-    this->SrcFileSignature, cmake::NO_BUILD_PARALLEL_LEVEL, &cmakeFlags,
-    output);
-  if (erroroc) {
-    cmSystemTools::SetErrorOccured();
+  if (resultCacheFile.empty() ||
+      !ReadCachedResult(resultCacheFile, res, output)) {
+    bool erroroc = cmSystemTools::GetErrorOccuredFlag();
+    cmSystemTools::ResetErrorOccuredFlag();
+    // Build the test targets of all probes with one invocation of the
+    // native build tool, running up to one job per probe.
+    std::vector<std::string> buildTargets;
+    for (TryCompileProbe const& p : probes) {
+      if (!p.TargetName.empty()) {
+        buildTargets.push_back(p.TargetName);
+      }
+    }
+    if (!this->SrcFileSignature && !targetName.empty()) {
+      buildTargets.push_back(targetName);
+    }
+    int const jobs = GetProbeBuildJobs(probes.size());
+    // actually do the try compile now that everything is setup
+    res = this->Makefile->TryCompile(
+      sourceDirectory, this->BinaryDirectory, projectName, buildTargets,
+      this->SrcFileSignature, jobs, &cmakeFlags, output);
+    // Do not remember results of a test project that failed to configure.
+    if (!resultCacheFile.empty() && !cmSystemTools::GetErrorOccuredFlag()) {
+      WriteCachedResult(resultCacheFile, res, output);
+    }
+    if (erroroc) {
+      cmSystemTools::SetErrorOccured();
+    }
   }
 
   // set the result var to the return value to indicate success or failure
-  this->Makefile->AddCacheDefinition(argv[0], (res == 0 ? "TRUE" : "FALSE"),
-                                     "Result of TRY_COMPILE",
-                                     cmStateEnums::INTERNAL);
+  if (probes.size() == 1) {
+    this->Makefile->AddCacheDefinition(argv[0], (res == 0 ? "TRUE" : "FALSE"),
+                                       "Result of TRY_COMPILE",
+                                       cmStateEnums::INTERNAL);
+  } else {
+    // When the build fails, a probe succeeded if its target was built.
+    cmGlobalGenerator* gg = this->Makefile->GetGlobalGenerator();
+    bool const keepGoing = !gg->GetKeepGoingBuildOptions().empty();
+    for (TryCompileProbe const& p : probes) {
+      int probeRes = res;
+      if (res != 0) {
+        this->FindOutputFile(p.TargetName, targetType);
+        probeRes = this->OutputFile.empty() ? 1 : 0;
+        // A build tool that stops at the first error may not have
+        // reached this target at all.
+        if (probeRes != 0 && !keepGoing &&
+            !cmSystemTools::GetFatalErrorOccured()) {
+          probeRes = gg->TryCompile(cmake::NO_BUILD_PARALLEL_LEVEL,
+                                    sourceDirectory, this->BinaryDirectory,
+                                    projectName, { p.TargetName }, true,
+                                    output, this->Makefile);
+        }
+      }
+      this->Makefile->AddCacheDefinition(
+        p.ResultVariable, (probeRes == 0 ? "TRUE" : "FALSE"),
+        "Result of TRY_COMPILE", cmStateEnums::INTERNAL);
+    }
+  }
 
   if (!outputVariable.empty()) {
     this->Makefile->AddDefinition(outputVariable, output);
@@ -16,22 +16,36 @@ cmDefinitions::Def const& cmDefinitions::GetInternal(const std::string& key,
                                                      StackIter end, bool raise)
 {
   assert(begin != end);
-  {
-    auto it = begin->Map.find(cm::String::borrow(key));
-    if (it != begin->Map.end()) {
-      return it->second;
+  Key const lookup(cm::String::borrow(key));
+  StackIter last = begin;
+  for (StackIter it = begin; it != end; ++it) {
+    last = it;
+    auto di = it->Map.find(lookup);
+    if (di == it->Map.end()) {
+      continue;
+    }
+    if (!raise || it == begin) {
+      return di->second;
     }
+    // Save the result locally in every scope searched before it was found.
+    return cmDefinitions::SaveLocally(key, di->second, begin, it);
   }
-  StackIter it = begin;
-  ++it;
-  if (it == end) {
+  if (!raise || last == begin) {
     return cmDefinitions::NoDef;
   }
-  Def const& def = cmDefinitions::GetInternal(key, it, end, raise);
-  if (!raise) {
-    return def;
+  return cmDefinitions::SaveLocally(key, cmDefinitions::NoDef, begin, last);
+}
+
+cmDefinitions::Def const& cmDefinitions::SaveLocally(const std::string& key,
+                                                     Def const& def,
+                                                     StackIter begin,
+                                                     StackIter end)
+{
+  Key const owned{ cm::String(key) };
+  for (StackIter it = begin; it != end; ++it) {
+    it->Map.emplace(owned, def);
   }
-  return begin->Map.emplace(key, def).first->second;
+  return begin->Map.find(owned)->second;
 }
 
 const std::string* cmDefinitions::Get(const std::string& key, StackIter begin,
@@ -50,8 +64,9 @@ void cmDefinitions::Raise(const std::string& key, StackIter begin,
 bool cmDefinitions::HasKey(const std::string& key, StackIter begin,
                            StackIter end)
 {
+  Key const lookup(cm::String::borrow(key));
   for (StackIter it = begin; it != end; ++it) {
-    if (it->Map.find(cm::String::borrow(key)) != it->Map.end()) {
+    if (it->Map.find(lookup) != it->Map.end()) {
       return true;
     }
   }
@@ -60,18 +75,28 @@ bool cmDefinitions::HasKey(const std::string& key, StackIter begin,
 
 cmDefinitions cmDefinitions::MakeClosure(StackIter begin, StackIter end)
 {
-  cmDefinitions closure;
+  // Start from a copy of the innermost scope.  Its keys are unique, so
+  // this avoids a lookup and a rehash per definition when creating each
+  // subdirectory scope from the closure of its parent directory.
+  cmDefinitions closure = *begin;
   std::unordered_set<cm::string_view> undefined;
-  for (StackIter it = begin; it != end; ++it) {
+  for (auto const& mi : begin->Map) {
+    if (!mi.second.Value) {
+      undefined.emplace(mi.first.Name.view());
+      closure.Map.erase(mi.first);
+    }
+  }
+  StackIter it = begin;
+  for (++it; it != end; ++it) {
     // Consider local definitions.
     for (auto const& mi : it->Map) {
       // Use this key if it is not already set or unset.
       if (closure.Map.find(mi.first) == closure.Map.end() &&
-          undefined.find(mi.first.view()) == undefined.end()) {
+          undefined.find(mi.first.Name.view()) == undefined.end()) {
         if (mi.second.Value) {
           closure.Map.insert(mi);
         } else {
-          undefined.emplace(mi.first.view());
+          undefined.emplace(mi.first.Name.view());
         }
       }
     }
@@ -89,8 +114,8 @@ std::vector<std::string> cmDefinitions::ClosureKeys(StackIter begin,
     defined.reserve(defined.size() + it->Map.size());
     for (auto const& mi : it->Map) {
       // Use this key if it is not already set or unset.
-      if (bound.emplace(mi.first.view()).second && mi.second.Value) {
-        defined.push_back(*mi.first.str_if_stable());
+      if (bound.emplace(mi.first.Name.view()).second && mi.second.Value) {
+        defined.push_back(*mi.first.Name.str_if_stable());
       }
     }
   }
@@ -100,10 +125,10 @@ std::vector<std::string> cmDefinitions::ClosureKeys(StackIter begin,
 
 void cmDefinitions::Set(const std::string& key, cm::string_view value)
 {
-  this->Map[key] = Def(value);
+  this->Map[Key(key)] = Def(value);
 }
 
 void cmDefinitions::Unset(const std::string& key)
 {
-  this->Map[key] = Def();
+  this->Map[Key(key)] = Def();
 }
@@ -4,9 +4,11 @@
 
 #include "cmConfigure.h" // IWYU pragma: keep
 
+#include <cstddef>
 #include <functional>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include <cm/string_view>
@@ -61,8 +63,30 @@ private:
   };
   static Def NoDef;
 
-  std::unordered_map<cm::String, Def> Map;
+  /** Variable name with a hash computed once for lookup in all scopes.  */
+  struct Key
+  {
+    Key(cm::String name)
+      : Name(std::move(name))
+      , Hash(std::hash<cm::String>{}(this->Name))
+    {
+    }
+    cm::String Name;
+    std::size_t Hash;
+    friend bool operator==(Key const& l, Key const& r)
+    {
+      return l.Hash == r.Hash && l.Name == r.Name;
+    }
+  };
+  struct KeyHash
+  {
+    std::size_t operator()(Key const& key) const noexcept { return key.Hash; }
+  };
+
+  std::unordered_map<Key, Def, KeyHash> Map;
 
   static Def const& GetInternal(const std::string& key, StackIter begin,
                                 StackIter end, bool raise);
+  static Def const& SaveLocally(const std::string& key, Def const& def,
+                                StackIter begin, StackIter end);
 };
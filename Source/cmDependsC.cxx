@@ -7,12 +7,17 @@
 #include "cmsys/FStream.hxx"
 
 #include "cmFileTime.h"
+#include "cmGeneratedFileStream.h"
 #include "cmLocalUnixMakefileGenerator3.h"
 #include "cmMakefile.h"
 #include "cmProperty.h"
 #include "cmStringAlgorithms.h"
 #include "cmSystemTools.h"
 
+#if !defined(CMAKE_BOOTSTRAP)
+#  include "cmCryptoHash.h"
+#endif
+
 #define INCLUDE_REGEX_LINE                                                    \
   "^[ \t]*[#%][ \t]*(include|import)[ \t]*[<\"]([^\">]+)([\">])"
 
@@ -23,6 +28,12 @@
 
 cmDependsC::cmDependsC() = default;
 
+bool cmDependsC::IsScannedLanguage(std::string const& lang)
+{
+  return lang == "C" || lang == "CXX" || lang == "RC" || lang == "ASM" ||
+    lang == "OBJC" || lang == "OBJCXX" || lang == "CUDA" || lang == "ISPC";
+}
+
 cmDependsC::cmDependsC(cmLocalUnixMakefileGenerator3* lg,
                        const std::string& targetDir, const std::string& lang,
                        const DependencyMap* validDeps)
@@ -63,12 +74,25 @@ cmDependsC::cmDependsC(cmLocalUnixMakefileGenerator3* lg,
   this->CacheFileName =
     cmStrCat(this->TargetDirectory, '/', lang, ".includecache");
 
-  this->ReadCacheFile();
+  this->ReadCacheFile(this->CacheFileName, this->FileCache);
+
+#if !defined(CMAKE_BOOTSTRAP)
+  // The result of scanning a file depends only on the regular expressions,
+  // so other targets scanned with the same ones may share their results.
+  cmCryptoHash hasher(cmCryptoHash::AlgoMD5);
+  this->SharedCacheDirectory = cmStrCat(
+    lg->GetBinaryDirectory(), "/CMakeFiles/CMakeIncludeCache/",
+    hasher.HashString(cmStrCat(
+      this->IncludeRegexLineString, '\n', this->IncludeRegexScanString, '\n',
+      this->IncludeRegexComplainString, '\n',
+      this->IncludeRegexTransformString)));
+#endif
 }
 
 cmDependsC::~cmDependsC()
 {
-  this->WriteCacheFile();
+  this->WriteCacheFile(this->CacheFileName, this->FileCache);
+  this->WriteSharedCacheEntries();
 }
 
 bool cmDependsC::WriteDependencies(const std::set<std::string>& sources,
@@ -172,6 +196,9 @@ bool cmDependsC::WriteDependencies(const std::set<std::string>& sources,
 
         // Check whether this file is already in the cache
         auto fileIt = this->FileCache.find(fullName);
+        if (fileIt == this->FileCache.end()) {
+          fileIt = this->ReadSharedCacheEntry(fullName);
+        }
         if (fileIt != this->FileCache.end()) {
           fileIt->second.Used = true;
           dependencies.insert(fullName);
@@ -217,24 +244,54 @@ bool cmDependsC::WriteDependencies(const std::set<std::string>& sources,
   internalDepends << obj_i << '\n';
 
   for (std::string const& dep : dependencies) {
-    makeDepends << obj_m << ": "
-                << this->LocalGenerator->ConvertToMakefilePath(
-                     this->LocalGenerator->MaybeConvertToRelativePath(binDir,
-                                                                      dep))
-                << '\n';
+    std::string dep_m = this->LocalGenerator->ConvertToMakefilePath(
+      this->LocalGenerator->MaybeConvertToRelativePath(binDir, dep));
+    makeDepends << obj_m << ": " << dep_m << '\n';
     internalDepends << ' ' << dep << '\n';
+    this->MakeDependencies.insert(std::move(dep_m));
   }
   makeDepends << '\n';
 
   return true;
 }
 
-void cmDependsC::ReadCacheFile()
+bool cmDependsC::Finalize(std::ostream& makeDepends,
+                          std::ostream& /*unused*/)
 {
-  if (this->CacheFileName.empty()) {
+  if (this->MakeDependencies.empty() ||
+      !this->LocalGenerator->GetMakefile()->IsOn(
+        "CMAKE_DEPENDS_SKIP_UNCHANGED")) {
+    return true;
+  }
+
+  // Let the build tool decide whether the dependencies must be scanned
+  // again.  Each dependency also gets an empty rule so that a removed
+  // file triggers scanning instead of failing the build.
+  std::string const stamp_m = this->LocalGenerator->ConvertToMakefilePath(
+    this->LocalGenerator->MaybeConvertToRelativePath(
+      this->LocalGenerator->GetBinaryDirectory(),
+      cmStrCat(this->TargetDirectory, "/depend.ts")));
+  makeDepends << "# Files whose change requires scanning again.\n";
+  for (std::string const& dep : this->MakeDependencies) {
+    makeDepends << stamp_m << ": " << dep << '\n';
+  }
+  makeDepends << '\n';
+  for (std::string const& dep : this->MakeDependencies) {
+    makeDepends << dep << ":\n";
+  }
+  makeDepends << '\n';
+
+  return true;
+}
+
+void cmDependsC::ReadCacheFile(
+  std::string const& fileName,
+  std::map<std::string, cmIncludeLines>& fileCache) const
+{
+  if (fileName.empty()) {
     return;
   }
-  cmsys::ifstream fin(this->CacheFileName.c_str());
+  cmsys::ifstream fin(fileName.c_str());
   if (!fin) {
     return;
   }
@@ -244,7 +301,7 @@ void cmDependsC::ReadCacheFile()
   bool haveFileName = false;
 
   cmFileTime cacheFileTime;
-  bool const cacheFileTimeGood = cacheFileTime.Load(this->CacheFileName);
+  bool const cacheFileTimeGood = cacheFileTime.Load(fileName);
   while (cmSystemTools::GetLineFromStream(fin, line)) {
     if (line.empty()) {
       cacheEntry = nullptr;
@@ -261,7 +318,9 @@ void cmDependsC::ReadCacheFile()
 
       if (res && newer) // cache is newer than the parsed file
       {
-        cacheEntry = &this->FileCache[line];
+        // Keep entries already loaded from another cache file.
+        auto inserted = fileCache.emplace(line, cmIncludeLines());
+        cacheEntry = inserted.second ? &inserted.first->second : nullptr;
       }
       // file doesn't exist, check that the regular expressions
       // haven't changed
@@ -297,12 +356,16 @@ void cmDependsC::ReadCacheFile()
   }
 }
 
-void cmDependsC::WriteCacheFile() const
+void cmDependsC::WriteCacheFile(
+  std::string const& fileName,
+  std::map<std::string, cmIncludeLines> const& fileCache) const
 {
-  if (this->CacheFileName.empty()) {
+  if (fileName.empty()) {
     return;
   }
-  cmsys::ofstream cacheOut(this->CacheFileName.c_str());
+  // Write to a temporary file and rename it so that concurrent readers
+  // never see a partially written cache.
+  cmGeneratedFileStream cacheOut(fileName);
   if (!cacheOut) {
     return;
   }
@@ -312,7 +375,7 @@ void cmDependsC::WriteCacheFile() const
   cacheOut << this->IncludeRegexComplainString << "\n\n";
   cacheOut << this->IncludeRegexTransformString << "\n\n";
 
-  for (auto const& fileIt : this->FileCache) {
+  for (auto const& fileIt : fileCache) {
     if (fileIt.second.Used) {
       cacheOut << fileIt.first << '\n';
 
@@ -329,11 +392,60 @@ void cmDependsC::WriteCacheFile() const
   }
 }
 
+std::string cmDependsC::GetSharedCacheEntryName(
+  std::string const& fullName) const
+{
+#if !defined(CMAKE_BOOTSTRAP)
+  if (!this->SharedCacheDirectory.empty()) {
+    cmCryptoHash hasher(cmCryptoHash::AlgoMD5);
+    return cmStrCat(this->SharedCacheDirectory, '/',
+                    hasher.HashString(fullName), ".includecache");
+  }
+#else
+  static_cast<void>(fullName);
+#endif
+  return std::string();
+}
+
+std::map<std::string, cmDependsC::cmIncludeLines>::iterator
+cmDependsC::ReadSharedCacheEntry(std::string const& fullName)
+{
+  std::string const entryName = this->GetSharedCacheEntryName(fullName);
+  if (!entryName.empty()) {
+    this->ReadCacheFile(entryName, this->FileCache);
+  }
+  return this->FileCache.find(fullName);
+}
+
+void cmDependsC::WriteSharedCacheEntries() const
+{
+  // Each scanned file has its own entry in the shared cache.  Targets
+  // scanned concurrently by a parallel build write different entries, or
+  // identical content for the same file, and every entry is renamed into
+  // place from a uniquely named temporary file, so no locking is needed.
+  if (this->SharedCacheUpdates.empty() ||
+      !cmSystemTools::MakeDirectory(this->SharedCacheDirectory)) {
+    return;
+  }
+  for (std::string const& fullName : this->SharedCacheUpdates) {
+    auto const fileIt = this->FileCache.find(fullName);
+    if (fileIt == this->FileCache.end()) {
+      continue;
+    }
+    std::map<std::string, cmIncludeLines> entry;
+    entry.insert(*fileIt);
+    this->WriteCacheFile(this->GetSharedCacheEntryName(fullName), entry);
+  }
+}
+
 void cmDependsC::Scan(std::istream& is, const std::string& directory,
                       const std::string& fullName)
 {
   cmIncludeLines& newCacheEntry = this->FileCache[fullName];
   newCacheEntry.Used = true;
+  if (!this->SharedCacheDirectory.empty()) {
+    this->SharedCacheUpdates.insert(fullName);
+  }
 
   // Read one line at a time.
   std::string line;
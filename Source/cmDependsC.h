@@ -35,11 +35,16 @@ public:
   cmDependsC(cmDependsC const&) = delete;
   cmDependsC& operator=(cmDependsC const&) = delete;
 
+  /** Whether sources of the given language are scanned by this class.  */
+  static bool IsScannedLanguage(std::string const& lang);
+
 protected:
   // Implement writing/checking methods required by superclass.
   bool WriteDependencies(const std::set<std::string>& sources,
                          const std::string& obj, std::ostream& makeDepends,
                          std::ostream& internalDepends) override;
+  bool Finalize(std::ostream& makeDepends,
+                std::ostream& internalDepends) override;
 
   // Method to scan a single file.
   void Scan(std::istream& is, const std::string& directory,
@@ -84,11 +89,26 @@ protected:
   std::set<std::string> Encountered;
   std::queue<UnscannedEntry> Unscanned;
 
+  // Dependencies of all objects, in the form written to the makefile.
+  std::set<std::string> MakeDependencies;
+
   std::map<std::string, cmIncludeLines> FileCache;
   std::map<std::string, std::string> HeaderLocationCache;
 
   std::string CacheFileName;
 
-  void WriteCacheFile() const;
-  void ReadCacheFile();
+  // Cache shared by all targets in the build tree that are scanned with
+  // the same regular expressions, holding one file per scanned file.
+  std::string SharedCacheDirectory;
+  std::set<std::string> SharedCacheUpdates;
+
+  void WriteCacheFile(std::string const& fileName,
+                      std::map<std::string, cmIncludeLines> const& fileCache)
+    const;
+  void ReadCacheFile(std::string const& fileName,
+                     std::map<std::string, cmIncludeLines>& fileCache) const;
+  std::string GetSharedCacheEntryName(std::string const& fullName) const;
+  std::map<std::string, cmIncludeLines>::iterator ReadSharedCacheEntry(
+    std::string const& fullName);
+  void WriteSharedCacheEntries() const;
 };
@@ -7,8 +7,10 @@
 #include "cmsys/Process.h"
 
 #include "cmExecutionStatus.h"
+#include "cmFileSystemCache.h"
 #include "cmMakefile.h"
 #include "cmProcessOutput.h"
+#include "cmState.h"
 #include "cmStringAlgorithms.h"
 #include "cmSystemTools.h"
 
@@ -98,6 +100,9 @@ bool cmExecProgramCommand(std::vector<std::string> const& args,
     retVal = -1;
   }
 
+  // The program may have changed anything.
+  status.GetMakefile().GetState()->GetFileSystemCache().Clear();
+
   if (!output_variable.empty()) {
     std::string::size_type first = output.find_first_not_of(" \n\t\r");
     std::string::size_type last = output.find_last_not_of(" \n\t\r");
@@ -36,6 +36,7 @@
 #include "cmFileCopier.h"
 #include "cmFileInstaller.h"
 #include "cmFileLockPool.h"
+#include "cmFileSystemCache.h"
 #include "cmFileTimes.h"
 #include "cmGeneratedFileStream.h"
 #include "cmGeneratorExpression.h"
@@ -3430,6 +3431,41 @@ bool HandleChmodRecurseCommand(std::vector<std::string> const& args,
   return HandleChmodCommandImpl(args, true, status);
 }
 
+// Tell the cache used by the find commands about paths that a file()
+// subcommand may have created, changed or removed.
+void InvalidateFileSystemCache(std::vector<std::string> const& args,
+                               cmExecutionStatus& status)
+{
+  cmMakefile& mf = status.GetMakefile();
+  cmFileSystemCache& fs = mf.GetState()->GetFileSystemCache();
+  auto invalidate = [&mf, &fs](std::string const& path) {
+    fs.Invalidate(
+      cmSystemTools::CollapseFullPath(path, mf.GetCurrentSourceDirectory()));
+  };
+
+  std::string const& subCommand = args[0];
+  if (subCommand == "WRITE" || subCommand == "APPEND" ||
+      subCommand == "LOCK") {
+    invalidate(args[1]);
+  } else if (subCommand == "MAKE_DIRECTORY" || subCommand == "REMOVE" ||
+             subCommand == "REMOVE_RECURSE" || subCommand == "TOUCH" ||
+             subCommand == "TOUCH_NOCREATE" || subCommand == "RENAME") {
+    for (std::string const& arg : cmMakeRange(args).advance(1)) {
+      invalidate(arg);
+    }
+  } else if (subCommand == "CREATE_LINK") {
+    if (args.size() > 2) {
+      invalidate(args[2]);
+    }
+  } else if (subCommand == "DOWNLOAD" || subCommand == "COPY" ||
+             subCommand == "INSTALL" || subCommand == "CONFIGURE" ||
+             subCommand == "ARCHIVE_CREATE" ||
+             subCommand == "ARCHIVE_EXTRACT" || subCommand == "CHMOD" ||
+             subCommand == "CHMOD_RECURSE") {
+    fs.Clear();
+  }
+}
+
 } // namespace
 
 bool cmFileCommand(std::vector<std::string> const& args,
@@ -3491,5 +3527,7 @@ bool cmFileCommand(std::vector<std::string> const& args,
     { "CHMOD_RECURSE"_s, HandleChmodRecurseCommand },
   };
 
-  return subcommand(args[0], args, status);
+  bool const result = subcommand(args[0], args, status);
+  InvalidateFileSystemCache(args, status);
+  return result;
 }
@@ -0,0 +1,286 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#include "cmFileSystemCache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include "cmsys/Directory.hxx"
+#include "cmsys/String.h"
+
+#include "cmStringAlgorithms.h"
+#include "cmSystemTools.h"
+
+namespace {
+bool IsRoot(std::string const& key)
+{
+#ifdef _WIN32
+  if (key.size() == 3 && key[1] == ':' && key[2] == '/') {
+    return true;
+  }
+#endif
+  return key == "/";
+}
+
+// Paths with "." or ".." components may name a location other than the
+// lexical one, so they are looked up but never reasoned about.
+bool IsNormal(std::string const& key)
+{
+  return key.compare(0, 2, "//") != 0 &&
+    key.find("/./") == std::string::npos &&
+    key.find("/../") == std::string::npos && !cmHasLiteralSuffix(key, "/.") &&
+    !cmHasLiteralSuffix(key, "/..");
+}
+
+std::string ParentOf(std::string const& key, std::string::size_type slash)
+{
+#ifdef _WIN32
+  if (slash == 2 && key[1] == ':') {
+    return key.substr(0, 3);
+  }
+#endif
+  return key.substr(0, slash == 0 ? 1 : slash);
+}
+
+// Whether 'path' is 'dir' or lies below it.
+bool IsWithin(std::string const& path, std::string const& dir)
+{
+  if (path.size() < dir.size()) {
+    return false;
+  }
+#if defined(_WIN32) || defined(__APPLE__)
+  if (cmsysString_strncasecmp(path.c_str(), dir.c_str(), dir.size()) != 0) {
+    return false;
+  }
+#else
+  if (path.compare(0, dir.size(), dir) != 0) {
+    return false;
+  }
+#endif
+  return path.size() == dir.size() || dir.back() == '/' ||
+    path[dir.size()] == '/';
+}
+
+bool ListDirectory(std::string const& key, std::vector<std::string>& names)
+{
+  cmsys::Directory dir;
+  if (!dir.Load(key)) {
+    return false;
+  }
+  for (unsigned long i = 0; i < dir.GetNumberOfFiles(); ++i) {
+    const char* name = dir.GetFile(i);
+    if (strcmp(name, ".") != 0 && strcmp(name, "..") != 0) {
+      names.emplace_back(name);
+    }
+  }
+  std::sort(names.begin(), names.end());
+  return true;
+}
+}
+
+bool cmFileSystemCache::FileExists(std::string const& path)
+{
+  ++this->Queries;
+  return this->Lookup(this->QueryKey(path)).Exists;
+}
+
+bool cmFileSystemCache::FileExists(std::string const& path, bool isFile)
+{
+  ++this->Queries;
+  Entry const& entry = this->Lookup(this->QueryKey(path));
+  return entry.Exists && (!isFile || !entry.IsDirectory);
+}
+
+bool cmFileSystemCache::FileIsDirectory(std::string const& path)
+{
+  ++this->Queries;
+  return this->Lookup(this->QueryKey(path)).IsDirectory;
+}
+
+bool cmFileSystemCache::FileIsExecutable(std::string const& path)
+{
+  ++this->Queries;
+  std::string const key = this->QueryKey(path);
+  Entry& entry = this->Lookup(key);
+  if (entry.Absent || entry.IsDirectory) {
+    return false;
+  }
+  // A file may be executable without being readable.
+  if (!entry.ExecutableKnown) {
+    entry.ExecutableKnown = true;
+    entry.IsExecutable = cmSystemTools::FileIsExecutable(key);
+    ++this->Stats;
+  }
+  return entry.IsExecutable;
+}
+
+std::vector<std::string> const& cmFileSystemCache::GetDirectoryEntries(
+  std::string const& dir)
+{
+  ++this->Queries;
+  std::string const key = this->QueryKey(dir);
+  Entry& entry = this->Entries[key];
+  if (!entry.Known || entry.IsDirectory) {
+    this->ReadDirectory(key, entry);
+  }
+  return entry.Names;
+}
+
+void cmFileSystemCache::Invalidate(std::string const& path)
+{
+  std::string key = MakeKey(path);
+  if (!IsNormal(key)) {
+    this->Clear();
+    return;
+  }
+  if (!this->BuildTree.empty() && IsWithin(key, this->BuildTree)) {
+    key = this->BuildTree;
+  }
+
+  for (auto i = this->Entries.begin(); i != this->Entries.end();) {
+    if (!IsNormal(i->first) || IsWithin(i->first, key)) {
+      i = this->Entries.erase(i);
+      continue;
+    }
+    if (IsWithin(key, i->first)) {
+      // The path may have been added to or removed from this directory,
+      // or created along with it.
+      Entry& entry = i->second;
+      entry.Listing = ListingState::NotRead;
+      entry.Names.clear();
+      if (!entry.IsDirectory) {
+        entry.Known = false;
+      }
+    }
+    ++i;
+  }
+}
+
+void cmFileSystemCache::Clear()
+{
+  this->Entries.clear();
+}
+
+void cmFileSystemCache::StartRecording()
+{
+  this->Recording = true;
+  this->Recorded.clear();
+}
+
+std::vector<std::string> cmFileSystemCache::StopRecording()
+{
+  this->Recording = false;
+  std::vector<std::string> keys = std::move(this->Recorded);
+  this->Recorded.clear();
+  std::sort(keys.begin(), keys.end());
+  keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+  // A path appears, disappears or changes kind by an update of the
+  // directory holding it, or of the nearest directory above it that
+  // exists.
+  std::vector<std::string> dirs;
+  for (std::string key : keys) {
+    while (!this->Lookup(key).IsDirectory) {
+      std::string::size_type const slash = key.rfind('/');
+      if (slash == std::string::npos || IsRoot(key)) {
+        key.clear();
+        break;
+      }
+      key = ParentOf(key, slash);
+    }
+    if (!key.empty()) {
+      dirs.push_back(std::move(key));
+    }
+  }
+  std::sort(dirs.begin(), dirs.end());
+  dirs.erase(std::unique(dirs.begin(), dirs.end()), dirs.end());
+  return dirs;
+}
+
+cmFileSystemCache::Entry& cmFileSystemCache::Lookup(std::string const& key)
+{
+  Entry& entry = this->Entries[key];
+  if (entry.Known) {
+    return entry;
+  }
+  entry.Known = true;
+  entry.Absent = false;
+  entry.Exists = false;
+  entry.IsDirectory = false;
+  entry.ExecutableKnown = false;
+
+  // A path below a missing directory is missing too.  Otherwise ask the
+  // file system: a name missing from the listing of its directory may
+  // still be reached, e.g. through an automount point that lists only
+  // mounted entries or through a Windows short name.
+  std::string::size_type const slash = key.rfind('/');
+  if (slash != std::string::npos && !IsRoot(key) && IsNormal(key)) {
+    std::string const parent = ParentOf(key, slash);
+    if (!this->Lookup(parent).IsDirectory) {
+      entry.Absent = true;
+      return entry;
+    }
+  }
+
+  entry.Exists = cmSystemTools::FileExists(key);
+  ++this->Stats;
+  if (entry.Exists) {
+    entry.IsDirectory = cmSystemTools::FileIsDirectory(key);
+    ++this->Stats;
+  } else {
+    entry.Absent = true;
+  }
+  return entry;
+}
+
+void cmFileSystemCache::ReadDirectory(std::string const& key, Entry& entry)
+{
+  if (entry.Listing != ListingState::NotRead) {
+    return;
+  }
+  ++this->DirectoryReads;
+  std::vector<std::string> names;
+  if (!ListDirectory(key, names)) {
+    entry.Listing = ListingState::Failed;
+    return;
+  }
+  StoreListing(entry, std::move(names));
+}
+
+void cmFileSystemCache::StoreListing(Entry& entry,
+                                     std::vector<std::string> names)
+{
+  entry.Listing = ListingState::Read;
+  entry.Names = std::move(names);
+}
+
+std::string cmFileSystemCache::QueryKey(std::string const& path)
+{
+  std::string key = MakeKey(path);
+  if (this->Recording) {
+    this->Recorded.push_back(key);
+  }
+  return key;
+}
+
+std::string cmFileSystemCache::MakeKey(std::string const& path)
+{
+  std::string key = cmSystemTools::FileIsFullPath(path)
+    ? path
+    : cmStrCat(cmSystemTools::GetCurrentWorkingDirectory(), '/', path);
+#ifdef _WIN32
+  std::replace(key.begin(), key.end(), '\\', '/');
+#endif
+
+  // Collapse repeated slashes, but keep a leading pair.
+  std::string::size_type const start = key.compare(0, 2, "//") == 0 ? 2 : 0;
+  key.erase(std::unique(key.begin() + start, key.end(),
+                        [](char l, char r) { return l == '/' && r == '/'; }),
+            key.end());
+
+  if (key.size() > 1 && key.back() == '/' && !IsRoot(key)) {
+    key.pop_back();
+  }
+  return key;
+}
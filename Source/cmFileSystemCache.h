@@ -0,0 +1,98 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file Copyright.txt or https://cmake.org/licensing for details.  */
+#pragma once
+
+#include "cmConfigure.h" // IWYU pragma: keep
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/** \class cmFileSystemCache
+ * \brief Caches file existence checks and directory listings.
+ *
+ * The find commands check the same prefixes again and again during a
+ * configure step.  This cache answers those checks from earlier results,
+ * including paths found to be missing.  Paths below a missing directory
+ * are known to be missing without asking the file system.  Commands that
+ * modify the file system must call Invalidate() or Clear().
+ */
+class cmFileSystemCache
+{
+public:
+  /** Cached versions of the cmSystemTools methods of the same name.  */
+  bool FileExists(std::string const& path);
+  bool FileExists(std::string const& path, bool isFile);
+  bool FileIsDirectory(std::string const& path);
+  bool FileIsExecutable(std::string const& path);
+
+  /**
+   * Get the sorted names of the entries of a directory, without "." and
+   * "..".  The list is empty if the directory cannot be read.  The
+   * reference is valid until the next call to Invalidate() or Clear().
+   */
+  std::vector<std::string> const& GetDirectoryEntries(std::string const& dir);
+
+  /**
+   * Forget everything known about a path, its contents and parents.
+   * Paths in the build tree may be aliased by symbolic links to other
+   * places in the build tree, so changes there forget the whole tree.
+   */
+  void Invalidate(std::string const& path);
+
+  void SetBuildTree(std::string const& dir) { this->BuildTree = MakeKey(dir); }
+
+  /** Forget everything.  */
+  void Clear();
+
+  /** Record the paths given to the query methods above.  */
+  void StartRecording();
+
+  /**
+   * Stop recording and get the directories whose modification times
+   * change when the answers to the recorded queries may change: each
+   * recorded directory, and the nearest existing directory above each
+   * other recorded path.
+   */
+  std::vector<std::string> StopRecording();
+
+  bool IsRecording() const { return this->Recording; }
+
+  unsigned long GetQueries() const { return this->Queries; }
+  unsigned long GetStats() const { return this->Stats; }
+  unsigned long GetDirectoryReads() const { return this->DirectoryReads; }
+
+private:
+  enum class ListingState
+  {
+    NotRead,
+    Read,
+    Failed
+  };
+  struct Entry
+  {
+    bool Known = false;
+    bool Absent = false;
+    bool Exists = false;
+    bool IsDirectory = false;
+    bool ExecutableKnown = false;
+    bool IsExecutable = false;
+    ListingState Listing = ListingState::NotRead;
+    std::vector<std::string> Names;
+  };
+
+  Entry& Lookup(std::string const& key);
+  void ReadDirectory(std::string const& key, Entry& entry);
+  static void StoreListing(Entry& entry, std::vector<std::string> names);
+
+  std::string QueryKey(std::string const& path);
+  static std::string MakeKey(std::string const& path);
+
+  std::unordered_map<std::string, Entry> Entries;
+  std::string BuildTree;
+  bool Recording = false;
+  std::vector<std::string> Recorded;
+  unsigned long Queries = 0;
+  unsigned long Stats = 0;
+  unsigned long DirectoryReads = 0;
+};
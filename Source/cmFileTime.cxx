@@ -2,6 +2,7 @@
    file Copyright.txt or https://cmake.org/licensing for details.  */
 #include "cmFileTime.h"
 
+#include <chrono>
 #include <ctime>
 #include <string>
 
@@ -48,3 +49,18 @@ bool cmFileTime::Load(std::string const& fileName)
 #endif
   return true;
 }
+
+void cmFileTime::LoadNow()
+{
+#if !defined(_WIN32) || defined(__CYGWIN__)
+  this->NS = std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::system_clock::now().time_since_epoch())
+               .count();
+#else
+  FILETIME ft;
+  GetSystemTimeAsFileTime(&ft);
+  this->NS = (static_cast<NSC>(ft.dwHighDateTime) << 32) |
+    static_cast<NSC>(ft.dwLowDateTime);
+  this->NS *= 100;
+#endif
+}
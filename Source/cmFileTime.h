@@ -25,6 +25,11 @@ public:
    */
   bool Load(std::string const& fileName);
 
+  /**
+   * @brief Sets this to the current time in the base of file times
+   */
+  void LoadNow();
+
   /**
    * @brief Return true if this is older than ftm
    */
@@ -5,12 +5,11 @@
 #include <algorithm>
 #include <cstdio>
 #include <cstring>
-#include <set>
 #include <utility>
 
 #include "cmsys/RegularExpression.hxx"
 
-#include "cmGlobalGenerator.h"
+#include "cmFileSystemCache.h"
 #include "cmMakefile.h"
 #include "cmMessageType.h"
 #include "cmProperty.h"
@@ -128,16 +127,17 @@ void cmFindLibraryCommand::AddArchitecturePath(
   std::string const& dir, std::string::size_type start_pos, const char* suffix,
   bool fresh)
 {
+  cmFileSystemCache& fs = this->Makefile->GetState()->GetFileSystemCache();
   std::string::size_type pos = dir.find("lib/", start_pos);
 
   if (pos != std::string::npos) {
     // Check for "lib".
     std::string lib = dir.substr(0, pos + 3);
-    bool use_lib = cmSystemTools::FileIsDirectory(lib);
+    bool use_lib = fs.FileIsDirectory(lib);
 
     // Check for "lib<suffix>" and use it first.
     std::string libX = lib + suffix;
-    bool use_libX = cmSystemTools::FileIsDirectory(libX);
+    bool use_libX = fs.FileIsDirectory(libX);
 
     // Avoid copies of the same directory due to symlinks.
     if (use_libX && use_lib && cmLibDirsLinked(libX, lib)) {
@@ -157,11 +157,11 @@ void cmFindLibraryCommand::AddArchitecturePath(
 
   if (fresh) {
     // Check for the original unchanged path.
-    bool use_dir = cmSystemTools::FileIsDirectory(dir);
+    bool use_dir = fs.FileIsDirectory(dir);
 
     // Check for <dir><suffix>/ and use it first.
     std::string dirX = dir + suffix;
-    bool use_dirX = cmSystemTools::FileIsDirectory(dirX);
+    bool use_dirX = fs.FileIsDirectory(dirX);
 
     // Avoid copies of the same directory due to symlinks.
     if (use_dirX && use_dir && cmLibDirsLinked(dirX, dir)) {
@@ -212,7 +212,7 @@ struct cmFindLibraryHelper
 
   // Context information.
   cmMakefile* Makefile;
-  cmGlobalGenerator* GG;
+  cmFileSystemCache* FileSystem;
 
   // List of valid prefixes and suffixes.
   std::vector<std::string> Prefixes;
@@ -286,7 +286,7 @@ cmFindLibraryHelper::cmFindLibraryHelper(cmMakefile* mf,
   , DebugMode(base->DebugModeEnabled())
   , DebugSearches("find_library", base)
 {
-  this->GG = this->Makefile->GetGlobalGenerator();
+  this->FileSystem = &this->Makefile->GetState()->GetFileSystemCache();
 
   // Collect the list of library name prefixes/suffixes to try.
   std::string const& prefixes_list =
@@ -405,7 +405,7 @@ bool cmFindLibraryHelper::CheckDirectoryForName(std::string const& path,
   if (name.TryRaw) {
     this->TestPath = cmStrCat(path, name.Raw);
 
-    const bool exists = cmSystemTools::FileExists(this->TestPath, true);
+    const bool exists = this->FileSystem->FileExists(this->TestPath, true);
     if (!exists) {
       this->DebugLibraryFailed(name.Raw, path);
     } else {
@@ -425,7 +425,8 @@ bool cmFindLibraryHelper::CheckDirectoryForName(std::string const& path,
   // Search for a file matching the library name regex.
   std::string dir = path;
   cmSystemTools::ConvertToUnixSlashes(dir);
-  std::set<std::string> const& files = this->GG->GetDirectoryContent(dir);
+  std::vector<std::string> const& files =
+    this->FileSystem->GetDirectoryEntries(dir);
   for (std::string const& origName : files) {
 #if defined(_WIN32) || defined(__APPLE__)
     std::string testName = cmSystemTools::LowerCase(origName);
@@ -435,7 +436,7 @@ bool cmFindLibraryHelper::CheckDirectoryForName(std::string const& path,
     if (name.Regex.find(testName)) {
       this->TestPath = cmStrCat(path, origName);
       // Make sure the path is readable and is not a directory.
-      if (cmSystemTools::FileExists(this->TestPath, true)) {
+      if (this->FileSystem->FileExists(this->TestPath, true)) {
         this->DebugLibraryFound(name.Raw, dir);
 
         // This is a matching file.  Check if it is better than the
@@ -528,12 +529,13 @@ std::string cmFindLibraryCommand::FindFrameworkLibrary()
 
 std::string cmFindLibraryCommand::FindFrameworkLibraryNamesPerDir()
 {
+  cmFileSystemCache& fs = this->Makefile->GetState()->GetFileSystemCache();
   std::string fwPath;
   // Search for all names in each search path.
   for (std::string const& d : this->SearchPaths) {
     for (std::string const& n : this->Names) {
       fwPath = cmStrCat(d, n, ".framework");
-      if (cmSystemTools::FileIsDirectory(fwPath)) {
+      if (fs.FileIsDirectory(fwPath)) {
         return cmSystemTools::CollapseFullPath(fwPath);
       }
     }
@@ -545,12 +547,13 @@ std::string cmFindLibraryCommand::FindFrameworkLibraryNamesPerDir()
 
 std::string cmFindLibraryCommand::FindFrameworkLibraryDirsPerName()
 {
+  cmFileSystemCache& fs = this->Makefile->GetState()->GetFileSystemCache();
   std::string fwPath;
   // Search for each name in all search paths.
   for (std::string const& n : this->Names) {
     for (std::string const& d : this->SearchPaths) {
       fwPath = cmStrCat(d, n, ".framework");
-      if (cmSystemTools::FileIsDirectory(fwPath)) {
+      if (fs.FileIsDirectory(fwPath)) {
         return cmSystemTools::CollapseFullPath(fwPath);
       }
     }
@@ -5,7 +5,6 @@
 #include <algorithm>
 #include <cassert>
 #include <cstdio>
-#include <cstring>
 #include <deque>
 #include <functional>
 #include <iterator>
@@ -22,6 +21,10 @@
 #include "cmsys/String.h"
 
 #include "cmAlgorithms.h"
+#include "cmCryptoHash.h"
+#include "cmFileSystemCache.h"
+#include "cmFileTime.h"
+#include "cmGeneratedFileStream.h"
 #include "cmMakefile.h"
 #include "cmMessageType.h"
 #include "cmPolicies.h"
@@ -33,6 +36,7 @@
 #include "cmStringAlgorithms.h"
 #include "cmSystemTools.h"
 #include "cmVersion.h"
+#include "cmake.h"
 
 #if defined(__HAIKU__)
 #  include <FindDirectory.h>
@@ -1082,41 +1086,73 @@ bool cmFindPackageCommand::FindConfig()
   // Compute the set of search prefixes.
   this->ComputePrefixes();
 
+  // Skip the search if it found no configuration file last time and
+  // none of the locations it looked at has changed since.
+  std::string const notFoundRecord = this->GetNotFoundRecordFile();
+  bool const skip =
+    !notFoundRecord.empty() && this->CheckNotFoundRecord(notFoundRecord);
+
   // Look for the project's configuration file.
   bool found = false;
-  if (this->DebugMode) {
+  if (this->DebugMode && !skip) {
     this->DebugBuffer = cmStrCat(this->DebugBuffer,
                                  "find_package considered the following "
                                  "locations for the Config module:\n");
   }
 
-  // Search for frameworks.
-  if (!found && (this->SearchFrameworkFirst || this->SearchFrameworkOnly)) {
-    found = this->FindFrameworkConfig();
-  }
+  if (!skip) {
+    cmFileSystemCache& fs = this->Makefile->GetState()->GetFileSystemCache();
+    if (!notFoundRecord.empty()) {
+      fs.StartRecording();
+    }
 
-  // Search for apps.
-  if (!found && (this->SearchAppBundleFirst || this->SearchAppBundleOnly)) {
-    found = this->FindAppBundleConfig();
-  }
+    // Search for frameworks.
+    if (!found && (this->SearchFrameworkFirst || this->SearchFrameworkOnly)) {
+      found = this->FindFrameworkConfig();
+    }
 
-  // Search prefixes.
-  if (!found && !(this->SearchFrameworkOnly || this->SearchAppBundleOnly)) {
-    found = this->FindPrefixedConfig();
-  }
+    // Search for apps.
+    if (!found && (this->SearchAppBundleFirst || this->SearchAppBundleOnly)) {
+      found = this->FindAppBundleConfig();
+    }
 
-  // Search for frameworks.
-  if (!found && this->SearchFrameworkLast) {
-    found = this->FindFrameworkConfig();
-  }
+    // Search prefixes.
+    if (!found && !(this->SearchFrameworkOnly || this->SearchAppBundleOnly)) {
+      found = this->FindPrefixedConfig();
+    }
+
+    // Search for frameworks.
+    if (!found && this->SearchFrameworkLast) {
+      found = this->FindFrameworkConfig();
+    }
+
+    // Search for apps.
+    if (!found && this->SearchAppBundleLast) {
+      found = this->FindAppBundleConfig();
+    }
 
-  // Search for apps.
-  if (!found && this->SearchAppBundleLast) {
-    found = this->FindAppBundleConfig();
+    if (!notFoundRecord.empty()) {
+      std::vector<std::string> const dirs = fs.StopRecording();
+      // Only a search that saw no configuration file at all may be
+      // skipped later.  One that was rejected for its version may be
+      // accepted once the requested version changes.
+      if (!found && this->ConsideredConfigs.empty()) {
+        this->WriteNotFoundRecord(notFoundRecord, dirs);
+      } else {
+        cmSystemTools::RemoveFile(notFoundRecord);
+      }
+    }
   }
 
   if (this->DebugMode) {
-    if (found) {
+    if (skip) {
+      this->DebugBuffer = cmStrCat(
+        this->DebugBuffer,
+        "find_package skipped the search for the Config module because "
+        "none of the locations considered by a previous search has "
+        "changed:\n  ",
+        notFoundRecord, "\n");
+    } else if (found) {
       this->DebugBuffer = cmStrCat(
         this->DebugBuffer, "The file was found at\n  ", this->FileFound, "\n");
     } else {
@@ -1142,6 +1178,80 @@ bool cmFindPackageCommand::FindConfig()
   return found;
 }
 
+std::string cmFindPackageCommand::GetNotFoundRecordFile() const
+{
+  if (!this->Makefile->IsOn("CMAKE_FIND_PACKAGE_CACHE_NOT_FOUND") ||
+      this->Makefile->GetCMakeInstance()->GetWorkingMode() !=
+        cmake::NORMAL_MODE) {
+    return std::string();
+  }
+
+  // Name the record after everything that decides where the search
+  // looks and which file names it looks for.
+  std::string key =
+    cmStrCat(cmVersion::GetCMakeVersion(), '\n', this->Name, '\n',
+             cmJoin(this->Names, ";"), '\n', cmJoin(this->Configs, ";"),
+             '\n', cmJoin(this->SearchPaths, ";"), '\n',
+             cmJoin(this->SearchPathSuffixes, ";"), '\n',
+             cmJoin(this->IgnoredPaths, ";"), '\n',
+             this->LibraryArchitecture, '\n');
+  for (bool flag :
+       { this->UseLib32Paths, this->UseLib64Paths, this->UseLibx32Paths,
+         this->SearchFrameworkFirst, this->SearchFrameworkOnly,
+         this->SearchFrameworkLast, this->SearchAppBundleFirst,
+         this->SearchAppBundleOnly, this->SearchAppBundleLast }) {
+    key += flag ? '1' : '0';
+  }
+  cmCryptoHash hasher(cmCryptoHash::AlgoSHA256);
+  return cmStrCat(this->Makefile->GetHomeOutputDirectory(),
+                  "/CMakeFiles/FindPackageNotFound/", this->Name, '-',
+                  hasher.HashString(key).substr(0, 16), ".txt");
+}
+
+bool cmFindPackageCommand::CheckNotFoundRecord(std::string const& file) const
+{
+  cmFileTime recordTime;
+  if (!recordTime.Load(file)) {
+    return false;
+  }
+  cmsys::ifstream fin(file.c_str());
+  if (!fin) {
+    return false;
+  }
+
+  cmFileTime::NSC ns;
+  std::string dir;
+  bool any = false;
+  while (fin >> ns && fin.get() == ' ' && std::getline(fin, dir)) {
+    // A directory modified shortly before the record was written may
+    // have been modified again within the resolution of its time stamp.
+    cmFileTime dirTime;
+    if (!dirTime.Load(dir) || dirTime.GetNS() != ns ||
+        ns > recordTime.GetNS() - 2 * cmFileTime::NsPerS) {
+      return false;
+    }
+    any = true;
+  }
+  return any && fin.eof();
+}
+
+void cmFindPackageCommand::WriteNotFoundRecord(
+  std::string const& file, std::vector<std::string> const& dirs) const
+{
+  std::string content;
+  for (std::string const& dir : dirs) {
+    cmFileTime dirTime;
+    if (!dirTime.Load(dir)) {
+      cmSystemTools::RemoveFile(file);
+      return;
+    }
+    content += cmStrCat(dirTime.GetNS(), ' ', dir, '\n');
+  }
+  cmGeneratedFileStream fout(file);
+  fout.SetCopyIfDifferent(false);
+  fout << content;
+}
+
 bool cmFindPackageCommand::FindPrefixedConfig()
 {
   std::vector<std::string> const& prefixes = this->SearchPaths;
@@ -1728,12 +1838,13 @@ bool cmFindPackageCommand::FindConfigFile(std::string const& dir,
     return false;
   }
 
+  cmFileSystemCache& fs = this->Makefile->GetState()->GetFileSystemCache();
   for (std::string const& c : this->Configs) {
     file = cmStrCat(dir, '/', c);
     if (this->DebugMode) {
       this->DebugBuffer = cmStrCat(this->DebugBuffer, "  ", file, "\n");
     }
-    if (cmSystemTools::FileExists(file, true) && this->CheckVersion(file)) {
+    if (fs.FileExists(file, true) && this->CheckVersion(file)) {
       // Allow resolving symlinks when the config file is found through a link
       if (this->UseRealPath) {
         file = cmSystemTools::GetRealPath(file);
@@ -1749,6 +1860,7 @@ bool cmFindPackageCommand::CheckVersion(std::string const& config_file)
   bool result = false; // by default, assume the version is not ok.
   bool haveResult = false;
   std::string version = "unknown";
+  cmFileSystemCache& fs = this->Makefile->GetState()->GetFileSystemCache();
 
   // Get the filename without the .cmake extension.
   std::string::size_type pos = config_file.rfind('.');
@@ -1756,14 +1868,14 @@ bool cmFindPackageCommand::CheckVersion(std::string const& config_file)
 
   // Look for foo-config-version.cmake
   std::string version_file = cmStrCat(version_file_base, "-version.cmake");
-  if (!haveResult && cmSystemTools::FileExists(version_file, true)) {
+  if (!haveResult && fs.FileExists(version_file, true)) {
     result = this->CheckVersionFile(version_file, version);
     haveResult = true;
   }
 
   // Look for fooConfigVersion.cmake
   version_file = cmStrCat(version_file_base, "Version.cmake");
-  if (!haveResult && cmSystemTools::FileExists(version_file, true)) {
+  if (!haveResult && fs.FileExists(version_file, true)) {
     result = this->CheckVersionFile(version_file, version);
     haveResult = true;
   }
@@ -1909,6 +2021,9 @@ public:
 
 protected:
   bool Consider(std::string const& fullPath, cmFileList& listing);
+  std::vector<std::string> const& ListDirectory(std::string const& dir,
+                                                cmFileList& listing);
+  static cmFileSystemCache& GetFileSystem(cmFileList& listing);
 
 private:
   bool Search(cmFileList&);
@@ -1922,6 +2037,10 @@ private:
 class cmFileList
 {
 public:
+  cmFileList(cmFileSystemCache& fileSystem)
+    : FileSystem(fileSystem)
+  {
+  }
   virtual ~cmFileList() = default;
   cmFileList& operator/(cmFileListGeneratorBase const& rhs)
   {
@@ -1944,6 +2063,7 @@ public:
 private:
   virtual bool Visit(std::string const& fullPath) = 0;
   friend class cmFileListGeneratorBase;
+  cmFileSystemCache& FileSystem;
   std::unique_ptr<cmFileListGeneratorBase> First;
   cmFileListGeneratorBase* Last = nullptr;
 };
@@ -1952,7 +2072,8 @@ class cmFindPackageFileList : public cmFileList
 {
 public:
   cmFindPackageFileList(cmFindPackageCommand* fpc, bool use_suffixes = true)
-    : FPC(fpc)
+    : cmFileList(fpc->Makefile->GetState()->GetFileSystemCache())
+    , FPC(fpc)
     , UseSuffixes(use_suffixes)
   {
   }
@@ -1984,7 +2105,7 @@ cmFileListGeneratorBase* cmFileListGeneratorBase::SetNext(
 bool cmFileListGeneratorBase::Consider(std::string const& fullPath,
                                        cmFileList& listing)
 {
-  if (!fullPath.empty() && !cmSystemTools::FileIsDirectory(fullPath)) {
+  if (!fullPath.empty() && !listing.FileSystem.FileIsDirectory(fullPath)) {
     return false;
   }
   if (this->Next) {
@@ -1993,6 +2114,17 @@ bool cmFileListGeneratorBase::Consider(std::string const& fullPath,
   return listing.Visit(fullPath + "/");
 }
 
+std::vector<std::string> const& cmFileListGeneratorBase::ListDirectory(
+  std::string const& dir, cmFileList& listing)
+{
+  return listing.FileSystem.GetDirectoryEntries(dir);
+}
+
+cmFileSystemCache& cmFileListGeneratorBase::GetFileSystem(cmFileList& listing)
+{
+  return listing.FileSystem;
+}
+
 class cmFileListGeneratorFixed : public cmFileListGeneratorBase
 {
 public:
@@ -2085,16 +2217,11 @@ private:
   {
     // Construct a list of matches.
     std::vector<std::string> matches;
-    cmsys::Directory d;
-    d.Load(parent);
-    for (unsigned long i = 0; i < d.GetNumberOfFiles(); ++i) {
-      const char* fname = d.GetFile(i);
-      if (strcmp(fname, ".") == 0 || strcmp(fname, "..") == 0) {
-        continue;
-      }
+    for (std::string const& fname : this->ListDirectory(parent, lister)) {
       for (std::string const& n : this->Names) {
-        if (cmsysString_strncasecmp(fname, n.c_str(), n.length()) == 0) {
-          matches.emplace_back(fname);
+        if (cmsysString_strncasecmp(fname.c_str(), n.c_str(), n.length()) ==
+            0) {
+          matches.push_back(fname);
         }
       }
     }
@@ -2143,17 +2270,11 @@ private:
   {
     // Construct a list of matches.
     std::vector<std::string> matches;
-    cmsys::Directory d;
-    d.Load(parent);
-    for (unsigned long i = 0; i < d.GetNumberOfFiles(); ++i) {
-      const char* fname = d.GetFile(i);
-      if (strcmp(fname, ".") == 0 || strcmp(fname, "..") == 0) {
-        continue;
-      }
+    for (std::string const& fname : this->ListDirectory(parent, lister)) {
       for (std::string name : this->Names) {
         name += this->Extension;
-        if (cmsysString_strcasecmp(fname, name.c_str()) == 0) {
-          matches.emplace_back(fname);
+        if (cmsysString_strcasecmp(fname.c_str(), name.c_str()) == 0) {
+          matches.push_back(fname);
         }
       }
     }
@@ -2192,17 +2313,15 @@ private:
   {
     // Look for matching files.
     std::vector<std::string> matches;
-    cmsys::Directory d;
-    d.Load(parent);
-    for (unsigned long i = 0; i < d.GetNumberOfFiles(); ++i) {
-      const char* fname = d.GetFile(i);
-      if (strcmp(fname, ".") == 0 || strcmp(fname, "..") == 0) {
-        continue;
+    for (std::string const& fname : this->ListDirectory(parent, lister)) {
+      if (cmsysString_strcasecmp(fname.c_str(), this->String.c_str()) == 0) {
+        matches.push_back(fname);
       }
-      if (cmsysString_strcasecmp(fname, this->String.c_str()) == 0) {
-        if (this->Consider(parent + fname, lister)) {
-          return true;
-        }
+    }
+
+    for (std::string const& i : matches) {
+      if (this->Consider(parent + i, lister)) {
+        return true;
       }
     }
     return false;
@@ -2231,6 +2350,15 @@ private:
   std::string Pattern;
   bool Search(std::string const& parent, cmFileList& lister) override
   {
+    // The glob does not go through the file system cache.  Tell a
+    // recorded search which directories the leading wildcard may match.
+    cmFileSystemCache& fs = GetFileSystem(lister);
+    if (fs.IsRecording()) {
+      for (std::string const& name : fs.GetDirectoryEntries(parent)) {
+        fs.FileIsDirectory(cmStrCat(parent, name));
+      }
+    }
+
     // Glob the set of matching files.
     std::string expr = cmStrCat(parent, this->Pattern);
     cmsys::Glob g;
@@ -2258,7 +2386,8 @@ bool cmFindPackageCommand::SearchPrefix(std::string const& prefix_in)
   assert(!prefix_in.empty() && prefix_in.back() == '/');
 
   // Skip this if the prefix does not exist.
-  if (!cmSystemTools::FileIsDirectory(prefix_in)) {
+  if (!this->Makefile->GetState()->GetFileSystemCache().FileIsDirectory(
+        prefix_in)) {
     return false;
   }
 
@@ -109,6 +109,10 @@ private:
   bool HandlePackageMode(HandlePackageModeType type);
 
   bool FindConfig();
+  std::string GetNotFoundRecordFile() const;
+  bool CheckNotFoundRecord(std::string const& file) const;
+  void WriteNotFoundRecord(std::string const& file,
+                           std::vector<std::string> const& dirs) const;
   bool FindPrefixedConfig();
   bool FindFrameworkConfig();
   bool FindAppBundleConfig();
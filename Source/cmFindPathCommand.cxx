@@ -4,8 +4,10 @@
 
 #include "cmsys/Glob.hxx"
 
+#include "cmFileSystemCache.h"
 #include "cmMakefile.h"
 #include "cmMessageType.h"
+#include "cmState.h"
 #include "cmStateTypes.h"
 #include "cmStringAlgorithms.h"
 #include "cmSystemTools.h"
@@ -103,7 +105,8 @@ std::string cmFindPathCommand::FindHeaderInFramework(std::string const& file,
     if (!frameWorkName.empty()) {
       std::string fpath = cmStrCat(dir, frameWorkName, ".framework");
       std::string intPath = cmStrCat(fpath, "/Headers/", fileName);
-      if (cmSystemTools::FileExists(intPath)) {
+      if (this->Makefile->GetState()->GetFileSystemCache().FileExists(
+            intPath)) {
         if (this->IncludeFileInPath) {
           return intPath;
         }
@@ -130,11 +133,12 @@ std::string cmFindPathCommand::FindHeaderInFramework(std::string const& file,
 
 std::string cmFindPathCommand::FindNormalHeader(cmFindBaseDebugState& debug)
 {
+  cmFileSystemCache& fs = this->Makefile->GetState()->GetFileSystemCache();
   std::string tryPath;
   for (std::string const& n : this->Names) {
     for (std::string const& sp : this->SearchPaths) {
       tryPath = cmStrCat(sp, n);
-      if (cmSystemTools::FileExists(tryPath)) {
+      if (fs.FileExists(tryPath)) {
         debug.FoundAt(tryPath);
         if (this->IncludeFileInPath) {
           return tryPath;
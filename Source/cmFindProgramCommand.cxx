@@ -2,9 +2,11 @@
    file Copyright.txt or https://cmake.org/licensing for details.  */
 #include "cmFindProgramCommand.h"
 
+#include "cmFileSystemCache.h"
 #include "cmMakefile.h"
 #include "cmMessageType.h"
 #include "cmPolicies.h"
+#include "cmState.h"
 #include "cmStateTypes.h"
 #include "cmStringAlgorithms.h"
 #include "cmSystemTools.h"
@@ -20,6 +22,7 @@ struct cmFindProgramHelper
   cmFindProgramHelper(cmMakefile* makefile, cmFindBase const* base)
     : DebugSearches("find_program", base)
     , Makefile(makefile)
+    , FileSystem(makefile->GetState()->GetFileSystemCache())
     , PolicyCMP0109(makefile->GetPolicyStatus(cmPolicies::CMP0109))
   {
 #if defined(_WIN32) || defined(__CYGWIN__) || defined(__MINGW32__)
@@ -49,6 +52,7 @@ struct cmFindProgramHelper
   // Debug state
   cmFindBaseDebugState DebugSearches;
   cmMakefile* Makefile;
+  cmFileSystemCache& FileSystem;
 
   cmPolicies::PolicyStatus PolicyCMP0109;
 
@@ -103,16 +107,16 @@ struct cmFindProgramHelper
   {
     switch (this->PolicyCMP0109) {
       case cmPolicies::OLD:
-        return cmSystemTools::FileExists(file, true);
+        return this->FileSystem.FileExists(file, true);
       case cmPolicies::NEW:
       case cmPolicies::REQUIRED_ALWAYS:
       case cmPolicies::REQUIRED_IF_USED:
-        return cmSystemTools::FileIsExecutable(file);
+        return this->FileSystem.FileIsExecutable(file);
       default:
         break;
     }
-    bool const isExeOld = cmSystemTools::FileExists(file, true);
-    bool const isExeNew = cmSystemTools::FileIsExecutable(file);
+    bool const isExeOld = this->FileSystem.FileExists(file, true);
+    bool const isExeNew = this->FileSystem.FileIsExecutable(file);
     if (isExeNew == isExeOld) {
       return isExeNew;
     }
@@ -2,6 +2,7 @@
    file Copyright.txt or https://cmake.org/licensing for details.  */
 #include "cmFunctionCommand.h"
 
+#include <memory>
 #include <utility>
 
 #include <cm/memory>
@@ -42,11 +43,18 @@ public:
   bool operator()(std::vector<cmListFileArgument> const& args,
                   cmExecutionStatus& inStatus) const;
 
-  std::vector<std::string> Args;
-  std::vector<cmListFileFunction> Functions;
-  cmPolicies::PolicyMap Policies;
-  std::string FilePath;
-  long Line;
+  // The command is copied each time it is looked up for invocation,
+  // so share the recorded definition among all copies.
+  struct Definition
+  {
+    std::vector<std::string> Args;
+    std::vector<cmListFileFunction> Functions;
+    cmPolicies::PolicyMap Policies;
+    std::string FilePath;
+    std::string FileDir;
+    std::string Line;
+  };
+  std::shared_ptr<Definition const> Def;
 };
 
 bool cmFunctionHelperCommand::operator()(
@@ -54,6 +62,7 @@ bool cmFunctionHelperCommand::operator()(
   cmExecutionStatus& inStatus) const
 {
   cmMakefile& makefile = inStatus.GetMakefile();
+  Definition const& def = *this->Def;
 
   // Expand the argument list to the function.
   std::vector<std::string> expandedArgs;
@@ -61,16 +70,16 @@ bool cmFunctionHelperCommand::operator()(
 
   // make sure the number of arguments passed is at least the number
   // required by the signature
-  if (expandedArgs.size() < this->Args.size() - 1) {
+  if (expandedArgs.size() < def.Args.size() - 1) {
     auto const errorMsg = cmStrCat(
       "Function invoked with incorrect arguments for function named: ",
-      this->Args.front());
+      def.Args.front());
     inStatus.SetError(errorMsg);
     return false;
   }
 
-  cmMakefile::FunctionPushPop functionScope(&makefile, this->FilePath,
-                                            this->Policies);
+  cmMakefile::FunctionPushPop functionScope(&makefile, def.FilePath,
+                                            def.Policies);
 
   // set the value of argc
   makefile.AddDefinition(ARGC, std::to_string(expandedArgs.size()));
@@ -84,33 +93,31 @@ bool cmFunctionHelperCommand::operator()(
   }
 
   // define the formal arguments
-  for (auto j = 1u; j < this->Args.size(); ++j) {
-    makefile.AddDefinition(this->Args[j], expandedArgs[j - 1]);
+  for (auto j = 1u; j < def.Args.size(); ++j) {
+    makefile.AddDefinition(def.Args[j], expandedArgs[j - 1]);
   }
 
   // define ARGV and ARGN
   auto const argvDef = cmJoin(expandedArgs, ";");
-  auto const eit = expandedArgs.begin() + (this->Args.size() - 1);
+  auto const eit = expandedArgs.begin() + (def.Args.size() - 1);
   auto const argnDef = cmJoin(cmMakeRange(eit, expandedArgs.end()), ";");
   makefile.AddDefinition(ARGV, argvDef);
   makefile.MarkVariableAsUsed(ARGV);
   makefile.AddDefinition(ARGN, argnDef);
   makefile.MarkVariableAsUsed(ARGN);
 
-  makefile.AddDefinition(CMAKE_CURRENT_FUNCTION, this->Args.front());
+  makefile.AddDefinition(CMAKE_CURRENT_FUNCTION, def.Args.front());
   makefile.MarkVariableAsUsed(CMAKE_CURRENT_FUNCTION);
-  makefile.AddDefinition(CMAKE_CURRENT_FUNCTION_LIST_FILE, this->FilePath);
+  makefile.AddDefinition(CMAKE_CURRENT_FUNCTION_LIST_FILE, def.FilePath);
   makefile.MarkVariableAsUsed(CMAKE_CURRENT_FUNCTION_LIST_FILE);
-  makefile.AddDefinition(CMAKE_CURRENT_FUNCTION_LIST_DIR,
-                         cmSystemTools::GetFilenamePath(this->FilePath));
+  makefile.AddDefinition(CMAKE_CURRENT_FUNCTION_LIST_DIR, def.FileDir);
   makefile.MarkVariableAsUsed(CMAKE_CURRENT_FUNCTION_LIST_DIR);
-  makefile.AddDefinition(CMAKE_CURRENT_FUNCTION_LIST_LINE,
-                         std::to_string(this->Line));
+  makefile.AddDefinition(CMAKE_CURRENT_FUNCTION_LIST_LINE, def.Line);
   makefile.MarkVariableAsUsed(CMAKE_CURRENT_FUNCTION_LIST_LINE);
 
   // Invoke all the functions that were collected in the block.
   // for each function
-  for (cmListFileFunction const& func : this->Functions) {
+  for (cmListFileFunction const& func : def.Functions) {
     cmExecutionStatus status(makefile);
     if (!makefile.ExecuteCommand(func, status) || status.GetNestedError()) {
       // The error message should have already included the call stack
@@ -157,12 +164,15 @@ bool cmFunctionFunctionBlocker::Replay(
 {
   cmMakefile& mf = status.GetMakefile();
   // create a new command and add it to cmake
+  auto def = std::make_shared<cmFunctionHelperCommand::Definition>();
+  def->Args = this->Args;
+  def->Functions = std::move(functions);
+  def->FilePath = this->GetStartingContext().FilePath;
+  def->FileDir = cmSystemTools::GetFilenamePath(def->FilePath);
+  def->Line = std::to_string(this->GetStartingContext().Line);
+  mf.RecordPolicies(def->Policies);
   cmFunctionHelperCommand f;
-  f.Args = this->Args;
-  f.Functions = std::move(functions);
-  f.FilePath = this->GetStartingContext().FilePath;
-  f.Line = this->GetStartingContext().Line;
-  mf.RecordPolicies(f.Policies);
+  f.Def = std::move(def);
   return mf.GetState()->AddScriptedCommand(
     this->Args.front(),
     BT<cmState::Command>(std::move(f),
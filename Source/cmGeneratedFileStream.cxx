@@ -3,6 +3,7 @@
 #include "cmGeneratedFileStream.h"
 
 #include <cstdio>
+#include <cstring>
 
 #include "cmStringAlgorithms.h"
 #include "cmSystemTools.h"
@@ -19,6 +20,7 @@ cmGeneratedFileStream::cmGeneratedFileStream(Encoding encoding)
 #ifndef CMAKE_BOOTSTRAP
   if (encoding != codecvt::None) {
     imbue(std::locale(OriginalLocale, new codecvt(encoding)));
+    this->Encoded = true;
   }
 #else
   static_cast<void>(encoding);
@@ -38,6 +40,7 @@ cmGeneratedFileStream::cmGeneratedFileStream(std::string const& name,
 #ifndef CMAKE_BOOTSTRAP
   if (encoding != codecvt::None) {
     imbue(std::locale(getloc(), new codecvt(encoding)));
+    this->Encoded = true;
   }
 #else
   static_cast<void>(encoding);
@@ -60,7 +63,14 @@ cmGeneratedFileStream& cmGeneratedFileStream::Open(std::string const& name,
   // Store the file name and construct the temporary file name.
   this->cmGeneratedFileStreamBase::Open(name);
 
+  // Go back to the file buffer if the stream was used before.
+  if (this->std::ios::rdbuf() == &this->MemoryBuffer) {
+    this->InMemory = false;
+    this->std::ios::rdbuf(this->Stream::rdbuf());
+  }
+
   // Open the temporary output file.
+  this->Binary = binaryFlag;
   if (binaryFlag) {
     this->Stream::open(this->TempName.c_str(),
                        std::ios::out | std::ios::binary);
@@ -73,6 +83,9 @@ cmGeneratedFileStream& cmGeneratedFileStream::Open(std::string const& name,
     cmSystemTools::Error("Cannot open file for write: " + this->TempName);
     cmSystemTools::ReportLastSystemError("");
   }
+  if (this->CopyIfDifferent) {
+    this->KeepInMemory();
+  }
   return *this;
 }
 
@@ -82,15 +95,43 @@ bool cmGeneratedFileStream::Close()
   this->Okay = !this->fail();
 
   // Close the temporary output file.
-  this->Stream::close();
+  if (!this->InMemory) {
+    this->Stream::close();
+  }
 
   // Remove the temporary file (possibly by renaming to the real file).
   return this->cmGeneratedFileStreamBase::Close();
 }
 
+void cmGeneratedFileStream::close()
+{
+  // The temporary file is not open while output is held in memory.
+  if (!this->InMemory) {
+    this->Stream::close();
+  }
+}
+
 void cmGeneratedFileStream::SetCopyIfDifferent(bool copy_if_different)
 {
   this->CopyIfDifferent = copy_if_different;
+  if (copy_if_different) {
+    this->KeepInMemory();
+  }
+}
+
+void cmGeneratedFileStream::KeepInMemory()
+{
+  // The temporary file has been opened, so it could be written later.
+  // The memory buffer cannot convert the encoding.
+  if (this->InMemory || this->Encoded || !this->Stream::is_open() ||
+      this->tellp() != 0) {
+    return;
+  }
+  this->Stream::close();
+  cmSystemTools::RemoveFile(this->TempName);
+  this->MemoryBuffer.str(std::string());
+  this->std::ios::rdbuf(&this->MemoryBuffer);
+  this->InMemory = true;
 }
 
 void cmGeneratedFileStream::SetCompression(bool compression)
@@ -151,10 +192,34 @@ bool cmGeneratedFileStreamBase::Close()
     resname += ".gz";
   }
 
+  // Write output held in memory to the temporary file only if it is
+  // to replace the destination.
+  bool differs = false;
+  bool unchanged = false;
+  if (this->InMemory) {
+    std::string const content = this->MemoryBuffer.str();
+    this->InMemory = false;
+    this->MemoryBuffer.str(std::string());
+    if (!this->Name.empty() && this->Okay) {
+      if (this->Compress || this->FileDiffers(resname, content)) {
+        cmsys::ofstream fout(this->TempName.c_str(),
+                             this->Binary ? std::ios::out | std::ios::binary
+                                          : std::ios::out);
+        fout.write(content.data(),
+                   static_cast<std::streamsize>(content.size()));
+        fout.close();
+        this->Okay = !fout.fail();
+        differs = !this->Compress;
+      } else {
+        unchanged = true;
+      }
+    }
+  }
+
   // Only consider replacing the destination file if no error
   // occurred.
-  if (!this->Name.empty() && this->Okay &&
-      (!this->CopyIfDifferent ||
+  if (!this->Name.empty() && this->Okay && !unchanged &&
+      (!this->CopyIfDifferent || differs ||
        cmSystemTools::FilesDiffer(this->TempName, resname))) {
     // The destination is to be replaced.  Rename the temporary to the
     // destination atomically.
@@ -179,6 +244,31 @@ bool cmGeneratedFileStreamBase::Close()
   return replaced;
 }
 
+bool cmGeneratedFileStreamBase::FileDiffers(std::string const& fname,
+                                            std::string const& content) const
+{
+  // Read in the same mode as the file would be written.
+  cmsys::ifstream fin(fname.c_str(),
+                      this->Binary ? std::ios::in | std::ios::binary
+                                   : std::ios::in);
+  if (!fin) {
+    return true;
+  }
+  char buffer[4096];
+  std::string::size_type pos = 0;
+  while (fin) {
+    fin.read(buffer, sizeof(buffer));
+    std::string::size_type const count =
+      static_cast<std::string::size_type>(fin.gcount());
+    if (count > content.size() - pos ||
+        memcmp(buffer, content.data() + pos, count) != 0) {
+      return true;
+    }
+    pos += count;
+  }
+  return pos != content.size();
+}
+
 #ifndef CMAKE_BOOTSTRAP
 int cmGeneratedFileStreamBase::CompressFile(std::string const& oldname,
                                             std::string const& newname)
@@ -4,6 +4,7 @@
 
 #include "cmConfigure.h" // IWYU pragma: keep
 
+#include <sstream>
 #include <string>
 
 #include "cmsys/FStream.hxx"
@@ -39,6 +40,9 @@ protected:
   // Internal file compression implementation.
   int CompressFile(std::string const& oldname, std::string const& newname);
 
+  // Whether a file has other content than given.
+  bool FileDiffers(std::string const& fname, std::string const& content) const;
+
   // The name of the final destination file for the output.
   std::string Name;
 
@@ -59,6 +63,15 @@ protected:
 
   // Whether the destination file is compressed
   bool CompressExtraExtension = true;
+
+  // Whether the temporary file is opened in binary mode.
+  bool Binary = false;
+
+  // Whether the output is kept in the memory buffer instead of the
+  // temporary file.  The buffer is written to the temporary file only
+  // if it differs from the destination.
+  bool InMemory = false;
+  std::stringbuf MemoryBuffer;
 };
 
 /** \class cmGeneratedFileStream
@@ -69,7 +82,8 @@ protected:
  * version.  This stream is used to make sure file generation is
  * atomic.  Optionally the output file is only replaced if its
  * contents have changed to prevent the file modification time from
- * being updated.
+ * being updated.  In that case the output is held in memory and
+ * written out only if it differs from the existing file.
  */
 class cmGeneratedFileStream
   : private cmGeneratedFileStreamBase
@@ -120,6 +134,12 @@ public:
    */
   bool Close();
 
+  /**
+   * Close the temporary output file but leave replacing the destination
+   * file to Close or the destructor.  Output held in memory is kept.
+   */
+  void close();
+
   /**
    * Set whether copy-if-different is done.
    */
@@ -154,6 +174,13 @@ public:
   void WriteRaw(std::string const& data);
 
 private:
+  // Switch a copy-if-different stream to the memory buffer before
+  // anything is written.
+  void KeepInMemory();
+
   // The original locale of the stream (performs no encoding conversion).
   std::locale OriginalLocale;
+
+  // Whether the stream converts the encoding of its output.
+  bool Encoded = false;
 };
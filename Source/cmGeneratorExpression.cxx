@@ -4,6 +4,7 @@
 
 #include <cassert>
 #include <memory>
+#include <tuple>
 #include <utility>
 
 #include "cmsys/RegularExpression.hxx"
@@ -13,6 +14,9 @@
 #include "cmGeneratorExpressionEvaluator.h"
 #include "cmGeneratorExpressionLexer.h"
 #include "cmGeneratorExpressionParser.h"
+#include "cmGeneratorTarget.h"
+#include "cmGlobalGenerator.h"
+#include "cmLocalGenerator.h"
 #include "cmStringAlgorithms.h"
 #include "cmSystemTools.h"
 
@@ -57,9 +61,46 @@ const std::string& cmCompiledGeneratorExpression::Evaluate(
     currentTarget ? currentTarget : headTarget, this->EvaluateForBuildsystem,
     this->Backtrace, language);
 
+  if (this->SupportsEvaluationCache && lg) {
+    if (cmGeneratorExpressionEvaluationCache* cache =
+          lg->GetGlobalGenerator()->GetGeneratorExpressionEvaluationCache()) {
+      return this->EvaluateWithCache(*cache, context, dagChecker);
+    }
+  }
+
   return this->EvaluateWithContext(context, dagChecker);
 }
 
+const std::string& cmCompiledGeneratorExpression::EvaluateWithCache(
+  cmGeneratorExpressionEvaluationCache& cache,
+  cmGeneratorExpressionContext& context,
+  cmGeneratorExpressionDAGChecker* dagChecker) const
+{
+  if (cmGeneratorExpressionEvaluationCache::Result const* result =
+        cache.Find(this->Input, context, dagChecker)) {
+    // No node which may be cached records targets or language standards.
+    this->Output = result->Output;
+    this->HadContextSensitiveCondition = result->HadContextSensitiveCondition;
+    this->HadHeadSensitiveCondition = result->HadHeadSensitiveCondition;
+    this->HadLinkLanguageSensitiveCondition = false;
+    this->SourceSensitiveTargets.clear();
+    this->MaxLanguageStandard.clear();
+    this->DependTargets.clear();
+    this->AllTargetsSeen.clear();
+    return this->Output;
+  }
+
+  this->EvaluateWithContext(context, dagChecker);
+  if (!context.HadError && !context.HadUncacheableNode) {
+    cmGeneratorExpressionEvaluationCache::Result result;
+    result.Output = this->Output;
+    result.HadContextSensitiveCondition = this->HadContextSensitiveCondition;
+    result.HadHeadSensitiveCondition = this->HadHeadSensitiveCondition;
+    cache.Store(this->Input, context, dagChecker, std::move(result));
+  }
+  return this->Output;
+}
+
 const std::string& cmCompiledGeneratorExpression::EvaluateWithContext(
   cmGeneratorExpressionContext& context,
   cmGeneratorExpressionDAGChecker* dagChecker) const
@@ -100,6 +141,7 @@ cmCompiledGeneratorExpression::cmCompiledGeneratorExpression(
   cmListFileBacktrace backtrace, std::string input)
   : Backtrace(std::move(backtrace))
   , Input(std::move(input))
+  , SupportsEvaluationCache(false)
   , EvaluateForBuildsystem(false)
   , Quiet(false)
   , HadContextSensitiveCondition(false)
@@ -113,6 +155,103 @@ cmCompiledGeneratorExpression::cmCompiledGeneratorExpression(
   if (this->NeedsEvaluation) {
     cmGeneratorExpressionParser p(tokens);
     p.Parse(this->Evaluators);
+
+    this->SupportsEvaluationCache = true;
+    for (const auto& it : this->Evaluators) {
+      if (!it->SupportsEvaluationCache()) {
+        this->SupportsEvaluationCache = false;
+        break;
+      }
+    }
+  }
+}
+
+bool cmGeneratorExpressionEvaluationCache::Key::operator<(
+  Key const& other) const
+{
+  return std::tie(this->Input, this->LocalGenerator, this->Config,
+                  this->Language, this->HaveHeadTarget,
+                  this->ImportedCurrentTarget, this->EvaluateForBuildsystem,
+                  this->HaveDAGChecker, this->TopProperty,
+                  this->TransitivePropertiesOnly) <
+    std::tie(other.Input, other.LocalGenerator, other.Config, other.Language,
+             other.HaveHeadTarget, other.ImportedCurrentTarget,
+             other.EvaluateForBuildsystem, other.HaveDAGChecker,
+             other.TopProperty, other.TransitivePropertiesOnly);
+}
+
+cmGeneratorExpressionEvaluationCache::Key
+cmGeneratorExpressionEvaluationCache::MakeKey(
+  std::string const& input, cmGeneratorExpressionContext const& context,
+  cmGeneratorExpressionDAGChecker const* dagChecker)
+{
+  Key key;
+  key.Input = input;
+  key.LocalGenerator = context.LG;
+  key.Config = context.Config;
+  key.Language = context.Language;
+  key.HaveHeadTarget = context.HeadTarget != nullptr;
+  key.ImportedCurrentTarget =
+    context.CurrentTarget && context.CurrentTarget->IsImported()
+    ? context.CurrentTarget
+    : nullptr;
+  key.EvaluateForBuildsystem = context.EvaluateForBuildsystem;
+  key.HaveDAGChecker = dagChecker != nullptr;
+  if (dagChecker) {
+    key.TopProperty = dagChecker->TopProperty();
+  }
+  key.TransitivePropertiesOnly =
+    dagChecker && dagChecker->GetTransitivePropertiesOnly();
+  return key;
+}
+
+cmGeneratorExpressionEvaluationCache::TargetKey
+cmGeneratorExpressionEvaluationCache::MakeTargetKey(
+  cmGeneratorExpressionContext const& context,
+  cmGeneratorExpressionDAGChecker const* dagChecker)
+{
+  return TargetKey(context.HeadTarget, context.CurrentTarget,
+                   dagChecker ? dagChecker->TopTarget() : nullptr);
+}
+
+cmGeneratorExpressionEvaluationCache::Result const*
+cmGeneratorExpressionEvaluationCache::Find(
+  std::string const& input, cmGeneratorExpressionContext const& context,
+  cmGeneratorExpressionDAGChecker const* dagChecker)
+{
+  // Whether an evaluation reads the head target does not depend on the
+  // head target, so one lookup without it tells whether a second one
+  // with the targets is needed.
+  auto it = this->Results.find(MakeKey(input, context, dagChecker));
+  if (it == this->Results.end()) {
+    ++this->Misses;
+    return nullptr;
+  }
+  Entry const& entry = it->second;
+  if (!entry.HeadSensitive) {
+    ++this->Hits;
+    return &entry.Shared;
+  }
+  auto ti = entry.PerTarget.find(MakeTargetKey(context, dagChecker));
+  if (ti == entry.PerTarget.end()) {
+    ++this->Misses;
+    return nullptr;
+  }
+  ++this->Hits;
+  return &ti->second;
+}
+
+void cmGeneratorExpressionEvaluationCache::Store(
+  std::string const& input, cmGeneratorExpressionContext const& context,
+  cmGeneratorExpressionDAGChecker const* dagChecker, Result result)
+{
+  Entry& entry = this->Results[MakeKey(input, context, dagChecker)];
+  if (result.HadHeadSensitiveCondition) {
+    entry.HeadSensitive = true;
+    entry.PerTarget.emplace(MakeTargetKey(context, dagChecker),
+                            std::move(result));
+  } else {
+    entry.Shared = std::move(result);
   }
 }
 
@@ -4,16 +4,19 @@
 
 #include "cmConfigure.h" // IWYU pragma: keep
 
+#include <cstddef>
 #include <map>
 #include <memory>
 #include <set>
 #include <string>
+#include <tuple>
 #include <utility>
 #include <vector>
 
 #include "cmListFileCache.h"
 
 class cmCompiledGeneratorExpression;
+class cmGeneratorExpressionEvaluationCache;
 class cmGeneratorTarget;
 class cmLocalGenerator;
 struct cmGeneratorExpressionContext;
@@ -152,6 +155,11 @@ private:
     cmGeneratorExpressionContext& context,
     cmGeneratorExpressionDAGChecker* dagChecker) const;
 
+  const std::string& EvaluateWithCache(
+    cmGeneratorExpressionEvaluationCache& cache,
+    cmGeneratorExpressionContext& context,
+    cmGeneratorExpressionDAGChecker* dagChecker) const;
+
   cmCompiledGeneratorExpression(cmListFileBacktrace backtrace,
                                 std::string input);
 
@@ -161,6 +169,7 @@ private:
   std::vector<std::unique_ptr<cmGeneratorExpressionEvaluator>> Evaluators;
   const std::string Input;
   bool NeedsEvaluation;
+  bool SupportsEvaluationCache;
   bool EvaluateForBuildsystem;
   bool Quiet;
 
@@ -177,6 +186,82 @@ private:
   mutable std::set<cmGeneratorTarget const*> SourceSensitiveTargets;
 };
 
+/** \class cmGeneratorExpressionEvaluationCache
+ * \brief Share results of generator expressions between evaluations.
+ *
+ * Results are keyed on the input string and on everything from the
+ * evaluation context that generator expressions without target-dependent
+ * nodes can observe.  Expressions containing such nodes, e.g.
+ * $<TARGET_PROPERTY>, are never cached.  The head and current targets
+ * are part of the key only for results that had a head-sensitive
+ * condition, so the usage requirements of a target evaluated for
+ * different consumers share one result.
+ */
+class cmGeneratorExpressionEvaluationCache
+{
+public:
+  struct Result
+  {
+    std::string Output;
+    bool HadContextSensitiveCondition = false;
+    bool HadHeadSensitiveCondition = false;
+  };
+
+  Result const* Find(std::string const& input,
+                     cmGeneratorExpressionContext const& context,
+                     cmGeneratorExpressionDAGChecker const* dagChecker);
+  void Store(std::string const& input,
+             cmGeneratorExpressionContext const& context,
+             cmGeneratorExpressionDAGChecker const* dagChecker,
+             Result result);
+
+  std::size_t GetHits() const { return this->Hits; }
+  std::size_t GetMisses() const { return this->Misses; }
+
+private:
+  struct Key
+  {
+    std::string Input;
+    cmLocalGenerator const* LocalGenerator;
+    std::string Config;
+    std::string Language;
+    // Nodes such as $<C_COMPILER_ID> fail without a head target.
+    bool HaveHeadTarget;
+    // $<CONFIG:cfg> reads the configuration map of an imported target.
+    cmGeneratorTarget const* ImportedCurrentTarget;
+    bool EvaluateForBuildsystem;
+    // The parts of the DAG checker read by nodes such as $<LINK_ONLY>.
+    bool HaveDAGChecker;
+    std::string TopProperty;
+    bool TransitivePropertiesOnly;
+
+    bool operator<(Key const& other) const;
+  };
+
+  // The head, current and DAG top targets of an evaluation.
+  using TargetKey = std::tuple<cmGeneratorTarget const*,
+                               cmGeneratorTarget const*,
+                               cmGeneratorTarget const*>;
+
+  struct Entry
+  {
+    bool HeadSensitive = false;
+    Result Shared;
+    std::map<TargetKey, Result> PerTarget;
+  };
+
+  static Key MakeKey(std::string const& input,
+                     cmGeneratorExpressionContext const& context,
+                     cmGeneratorExpressionDAGChecker const* dagChecker);
+  static TargetKey MakeTargetKey(
+    cmGeneratorExpressionContext const& context,
+    cmGeneratorExpressionDAGChecker const* dagChecker);
+
+  std::map<Key, Entry> Results;
+  std::size_t Hits = 0;
+  std::size_t Misses = 0;
+};
+
 class cmGeneratorExpressionInterpreter
 {
 public:
@@ -40,5 +40,8 @@ struct cmGeneratorExpressionContext
   bool HadContextSensitiveCondition;
   bool HadHeadSensitiveCondition;
   bool HadLinkLanguageSensitiveCondition;
+  // A node whose identifier was itself evaluated does not support the
+  // evaluation cache.
+  bool HadUncacheableNode;
   bool EvaluateForBuildsystem;
 };
@@ -212,6 +212,11 @@ cmGeneratorTarget const* cmGeneratorExpressionDAGChecker::TopTarget() const
   return this->Top()->Target;
 }
 
+std::string const& cmGeneratorExpressionDAGChecker::TopProperty() const
+{
+  return this->Top()->Property;
+}
+
 enum TransitiveProperty
 {
 #define DEFINE_ENUM_ENTRY(NAME) NAME,
@@ -21,6 +21,41 @@ std::string GeneratorExpressionContent::GetOriginalExpression() const
   return std::string(this->StartContent, this->ContentLength);
 }
 
+bool GeneratorExpressionContent::SupportsEvaluationCache() const
+{
+  // The node can only be known without evaluation for literal identifiers.
+  // Other nodes, such as $<$<CONFIG:cfg>:...>, are checked when evaluated.
+  std::string identifier;
+  bool literal = true;
+  for (auto& pExprEval : this->IdentifierChildren) {
+    if (pExprEval->GetType() != cmGeneratorExpressionEvaluator::Text) {
+      if (!pExprEval->SupportsEvaluationCache()) {
+        return false;
+      }
+      literal = false;
+    } else if (literal) {
+      identifier += pExprEval->Evaluate(nullptr, nullptr);
+    }
+  }
+
+  if (literal) {
+    const cmGeneratorExpressionNode* node =
+      cmGeneratorExpressionNode::GetNode(identifier);
+    if (!node || !node->SupportsEvaluationCache()) {
+      return false;
+    }
+  }
+
+  for (auto const& param : this->ParamChildren) {
+    for (auto const& pExprEval : param) {
+      if (!pExprEval->SupportsEvaluationCache()) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
 std::string GeneratorExpressionContent::ProcessArbitraryContent(
   const cmGeneratorExpressionNode* node, const std::string& identifier,
   cmGeneratorExpressionContext* context,
@@ -79,6 +114,9 @@ std::string GeneratorExpressionContent::Evaluate(
                 "Expression did not evaluate to a known generator expression");
     return std::string();
   }
+  if (!node->SupportsEvaluationCache()) {
+    context->HadUncacheableNode = true;
+  }
 
   if (!node->GeneratesContent()) {
     if (node->NumExpectedParameters() == 1 &&
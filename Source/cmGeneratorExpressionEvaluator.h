@@ -34,6 +34,8 @@ struct cmGeneratorExpressionEvaluator
 
   virtual std::string Evaluate(cmGeneratorExpressionContext* context,
                                cmGeneratorExpressionDAGChecker*) const = 0;
+
+  virtual bool SupportsEvaluationCache() const = 0;
 };
 
 using cmGeneratorExpressionEvaluatorVector =
@@ -58,6 +60,8 @@ struct TextContent : public cmGeneratorExpressionEvaluator
     return cmGeneratorExpressionEvaluator::Text;
   }
 
+  bool SupportsEvaluationCache() const override { return true; }
+
   void Extend(size_t length) { this->Length += length; }
 
   size_t GetLength() const { return this->Length; }
@@ -90,6 +94,8 @@ struct GeneratorExpressionContent : public cmGeneratorExpressionEvaluator
   std::string Evaluate(cmGeneratorExpressionContext* context,
                        cmGeneratorExpressionDAGChecker*) const override;
 
+  bool SupportsEvaluationCache() const override;
+
   std::string GetOriginalExpression() const;
 
   ~GeneratorExpressionContent() override;
@@ -397,6 +397,8 @@ static const struct TargetExistsNode : public cmGeneratorExpressionNode
 {
   TargetExistsNode() {} // NOLINT(modernize-use-equals-default)
 
+  bool SupportsEvaluationCache() const override { return false; }
+
   int NumExpectedParameters() const override { return 1; }
 
   std::string Evaluate(
@@ -428,6 +430,8 @@ static const struct TargetNameIfExistsNode : public cmGeneratorExpressionNode
 {
   TargetNameIfExistsNode() {} // NOLINT(modernize-use-equals-default)
 
+  bool SupportsEvaluationCache() const override { return false; }
+
   int NumExpectedParameters() const override { return 1; }
 
   std::string Evaluate(
@@ -462,6 +466,8 @@ struct GenexEvaluator : public cmGeneratorExpressionNode
 {
   GenexEvaluator() {} // NOLINT(modernize-use-equals-default)
 
+  bool SupportsEvaluationCache() const override { return false; }
+
 protected:
   std::string EvaluateExpression(
     const std::string& genexOperator, const std::string& expression,
@@ -1056,6 +1062,8 @@ static const struct LinkLanguageNode : public cmGeneratorExpressionNode
 {
   LinkLanguageNode() {} // NOLINT(modernize-use-equals-default)
 
+  bool SupportsEvaluationCache() const override { return false; }
+
   int NumExpectedParameters() const override { return ZeroOrMoreParameters; }
 
   std::string Evaluate(
@@ -1149,6 +1157,8 @@ static const struct LinkLanguageAndIdNode : public cmGeneratorExpressionNode
 {
   LinkLanguageAndIdNode() {} // NOLINT(modernize-use-equals-default)
 
+  bool SupportsEvaluationCache() const override { return false; }
+
   int NumExpectedParameters() const override { return TwoOrMoreParameters; }
 
   std::string Evaluate(
@@ -1200,6 +1210,8 @@ static const struct HostLinkNode : public cmGeneratorExpressionNode
 {
   HostLinkNode() {} // NOLINT(modernize-use-equals-default)
 
+  bool SupportsEvaluationCache() const override { return false; }
+
   int NumExpectedParameters() const override { return ZeroOrMoreParameters; }
 
   std::string Evaluate(
@@ -1225,6 +1237,8 @@ static const struct DeviceLinkNode : public cmGeneratorExpressionNode
 {
   DeviceLinkNode() {} // NOLINT(modernize-use-equals-default)
 
+  bool SupportsEvaluationCache() const override { return false; }
+
   int NumExpectedParameters() const override { return ZeroOrMoreParameters; }
 
   std::string Evaluate(
@@ -1298,6 +1312,8 @@ static const struct TargetPropertyNode : public cmGeneratorExpressionNode
 {
   TargetPropertyNode() {} // NOLINT(modernize-use-equals-default)
 
+  bool SupportsEvaluationCache() const override { return false; }
+
   // This node handles errors on parameter count itself.
   int NumExpectedParameters() const override { return OneOrMoreParameters; }
 
@@ -1604,6 +1620,8 @@ static const struct TargetObjectsNode : public cmGeneratorExpressionNode
 {
   TargetObjectsNode() {} // NOLINT(modernize-use-equals-default)
 
+  bool SupportsEvaluationCache() const override { return false; }
+
   std::string Evaluate(
     const std::vector<std::string>& parameters,
     cmGeneratorExpressionContext* context,
@@ -1691,6 +1709,8 @@ static const struct CompileFeaturesNode : public cmGeneratorExpressionNode
 {
   CompileFeaturesNode() {} // NOLINT(modernize-use-equals-default)
 
+  bool SupportsEvaluationCache() const override { return false; }
+
   int NumExpectedParameters() const override { return OneOrMoreParameters; }
 
   std::string Evaluate(
@@ -2157,6 +2177,8 @@ struct TargetArtifactBase : public cmGeneratorExpressionNode
 {
   TargetArtifactBase() {} // NOLINT(modernize-use-equals-default)
 
+  bool SupportsEvaluationCache() const override { return false; }
+
 protected:
   cmGeneratorTarget* GetTarget(
     const std::vector<std::string>& parameters,
@@ -33,6 +33,10 @@ struct cmGeneratorExpressionNode
 
   virtual int NumExpectedParameters() const { return 1; }
 
+  // Whether the result depends only on the parameters and on the
+  // evaluation context, but not on the state of other targets.
+  virtual bool SupportsEvaluationCache() const { return true; }
+
   virtual std::string Evaluate(
     const std::vector<std::string>& parameters,
     cmGeneratorExpressionContext* context,
@@ -26,12 +26,14 @@
 
 #include "cmAlgorithms.h"
 #include "cmCPackPropertiesGenerator.h"
+#include "cmComputeLinkDepends.h"
 #include "cmComputeTargetDepends.h"
 #include "cmCustomCommand.h"
 #include "cmCustomCommandLines.h"
 #include "cmDuration.h"
 #include "cmExportBuildFileGenerator.h"
 #include "cmExternalMakefileProjectGenerator.h"
+#include "cmFileSystemCache.h"
 #include "cmGeneratedFileStream.h"
 #include "cmGeneratorExpression.h"
 #include "cmGeneratorTarget.h"
@@ -58,6 +60,7 @@
 #  include <cm3p/json/writer.h>
 
 #  include "cmCryptoHash.h"
+#  include "cmMakefileProfilingData.h"
 #  include "cmQtAutoGenGlobalInitializer.h"
 #endif
 
@@ -1214,6 +1217,13 @@ void cmGlobalGenerator::Configure()
   this->ClearGeneratorMembers();
   this->NextDeferId = 0;
 
+  // Files may have changed since the last configure step.
+  cmFileSystemCache& fileSystemCache =
+    this->CMakeInstance->GetState()->GetFileSystemCache();
+  fileSystemCache.Clear();
+  fileSystemCache.SetBuildTree(this->CMakeInstance->GetHomeOutputDirectory());
+  this->CMakeInstance->GetState()->GetListFileCache().Clear();
+
   cmStateSnapshot snapshot = this->CMakeInstance->GetCurrentSnapshot();
 
   snapshot.GetDirectory().SetCurrentSource(
@@ -1235,6 +1245,19 @@ void cmGlobalGenerator::Configure()
   dirMf->Configure();
   dirMf->EnforceDirectoryLevelRules();
 
+#if !defined(CMAKE_BOOTSTRAP)
+  if (this->CMakeInstance->IsProfilingEnabled()) {
+    Json::Value counters;
+    counters["queries"] = Json::Value::UInt64(fileSystemCache.GetQueries());
+    counters["stats"] = Json::Value::UInt64(fileSystemCache.GetStats());
+    counters["directory reads"] =
+      Json::Value::UInt64(fileSystemCache.GetDirectoryReads());
+    this->CMakeInstance->GetProfilingOutput().CounterEntry(
+      "file system cache", counters);
+  }
+#endif
+  fileSystemCache.Clear();
+
   this->ConfigureDoneCMP0026AndCMP0024 = true;
 
   // Put a copy of each global target in every directory.
@@ -1496,6 +1519,13 @@ void cmGlobalGenerator::Generate()
   // it builds by default.
   this->InitializeProgressMarks();
 
+  // Targets and their properties no longer change, so results of
+  // generator expressions that depend only on their context may be shared.
+  this->GeneratorExpressionEvaluationCache =
+    cm::make_unique<cmGeneratorExpressionEvaluationCache>();
+  this->ComputeLinkDependsCache =
+    cm::make_unique<cmComputeLinkDependsCache>();
+
   this->ProcessEvaluationFiles();
 
   this->CMakeInstance->UpdateProgress("Generating", 0.1f);
@@ -1540,6 +1570,27 @@ void cmGlobalGenerator::Generate()
     this->ExtraGenerator->Generate();
   }
 
+#if !defined(CMAKE_BOOTSTRAP)
+  if (this->CMakeInstance->IsProfilingEnabled()) {
+    Json::Value counters;
+    counters["hits"] =
+      Json::Value::UInt64(this->GeneratorExpressionEvaluationCache->GetHits());
+    counters["misses"] = Json::Value::UInt64(
+      this->GeneratorExpressionEvaluationCache->GetMisses());
+    this->CMakeInstance->GetProfilingOutput().CounterEntry(
+      "genex evaluation cache", counters);
+    Json::Value linkCounters;
+    linkCounters["hits"] =
+      Json::Value::UInt64(this->ComputeLinkDependsCache->GetHits());
+    linkCounters["misses"] =
+      Json::Value::UInt64(this->ComputeLinkDependsCache->GetMisses());
+    this->CMakeInstance->GetProfilingOutput().CounterEntry(
+      "link dependency cache", linkCounters);
+  }
+#endif
+  this->GeneratorExpressionEvaluationCache.reset();
+  this->ComputeLinkDependsCache.reset();
+
   if (!this->CMP0042WarnTargets.empty()) {
     std::ostringstream w;
     w << cmPolicies::GetPolicyWarning(cmPolicies::CMP0042) << "\n";
@@ -1796,6 +1847,9 @@ void cmGlobalGenerator::CreateGeneratorTargets(TargetTypes targetTypes)
 
 void cmGlobalGenerator::ClearGeneratorMembers()
 {
+  this->GeneratorExpressionEvaluationCache.reset();
+  this->ComputeLinkDependsCache.reset();
+
   this->BuildExportSets.clear();
 
   this->Makefiles.clear();
@@ -1891,8 +1945,9 @@ void cmGlobalGenerator::CheckTargetProperties()
 int cmGlobalGenerator::TryCompile(int jobs, const std::string& srcdir,
                                   const std::string& bindir,
                                   const std::string& projectName,
-                                  const std::string& target, bool fast,
-                                  std::string& output, cmMakefile* mf)
+                                  std::vector<std::string> const& targetNames,
+                                  bool fast, std::string& output,
+                                  cmMakefile* mf)
 {
   // if this is not set, then this is a first time configure
   // and there is a good chance that the try compile stuff will
@@ -1912,14 +1967,16 @@ int cmGlobalGenerator::TryCompile(int jobs, const std::string& srcdir,
                                         this->FirstTimeProgress);
   }
 
-  std::vector<std::string> newTarget = {};
-  if (!target.empty()) {
-    newTarget = { target };
+  // Report the result of each target when building several of them.
+  std::vector<std::string> nativeOptions;
+  if (targetNames.size() > 1) {
+    nativeOptions = this->GetKeepGoingBuildOptions();
   }
   std::string config =
     mf->GetSafeDefinition("CMAKE_TRY_COMPILE_CONFIGURATION");
-  return this->Build(jobs, srcdir, bindir, projectName, newTarget, output, "",
-                     config, false, fast, false, this->TryCompileTimeout);
+  return this->Build(jobs, srcdir, bindir, projectName, targetNames, output,
+                     "", config, false, fast, false, this->TryCompileTimeout,
+                     cmSystemTools::OUTPUT_NONE, nativeOptions);
 }
 
 std::vector<cmGlobalGenerator::GeneratedMakeCommand>
@@ -2956,6 +3013,7 @@ void cmGlobalGenerator::AddToManifest(std::string const& f)
   DirectoryContent& dc = this->DirectoryContentMap[dir];
   dc.Generated.insert(file);
   dc.All.insert(file);
+  dc.FoldedValid = false;
 }
 
 std::set<std::string> const& cmGlobalGenerator::GetDirectoryContent(
@@ -2980,11 +3038,43 @@ std::set<std::string> const& cmGlobalGenerator::GetDirectoryContent(
         }
       }
       dc.LastDiskTime = mt;
+      dc.FoldedValid = false;
     }
   }
   return dc.All;
 }
 
+std::set<std::string> const& cmGlobalGenerator::GetFoldedDirectoryContent(
+  std::string const& dir)
+{
+  std::set<std::string> const& all = this->GetDirectoryContent(dir, true);
+#if defined(_WIN32) || defined(__APPLE__)
+  // The file system may be case-insensitive.  Fold the names once for
+  // each change to the content rather than on every lookup.
+  DirectoryContent& dc = this->DirectoryContentMap[dir];
+  if (!dc.FoldedValid) {
+    dc.Folded.clear();
+    for (std::string const& name : all) {
+      dc.Folded.insert(cmSystemTools::LowerCase(name));
+    }
+    dc.FoldedValid = true;
+  }
+  return dc.Folded;
+#else
+  return all;
+#endif
+}
+
+std::string cmGlobalGenerator::FoldDirectoryContentName(
+  std::string const& name)
+{
+#if defined(_WIN32) || defined(__APPLE__)
+  return cmSystemTools::LowerCase(name);
+#else
+  return name;
+#endif
+}
+
 void cmGlobalGenerator::AddRuleHash(const std::vector<std::string>& outputs,
                                     std::string const& content)
 {
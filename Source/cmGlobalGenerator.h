@@ -40,6 +40,8 @@
 class cmDirectoryId;
 class cmExportBuildFileGenerator;
 class cmExternalMakefileProjectGenerator;
+class cmComputeLinkDependsCache;
+class cmGeneratorExpressionEvaluationCache;
 class cmGeneratorTarget;
 class cmLinkLineComputer;
 class cmLocalGenerator;
@@ -211,8 +213,8 @@ public:
    */
   int TryCompile(int jobs, const std::string& srcdir,
                  const std::string& bindir, const std::string& projectName,
-                 const std::string& targetName, bool fast, std::string& output,
-                 cmMakefile* mf);
+                 std::vector<std::string> const& targetNames, bool fast,
+                 std::string& output, cmMakefile* mf);
 
   /**
    * Build a file given the following information. This is a more direct call
@@ -248,6 +250,13 @@ public:
 
   virtual void PrintBuildCommandAdvice(std::ostream& os, int jobs) const;
 
+  /** Native build tool options that keep it building other targets after
+      one of them fails.  Empty if the build tool offers no such mode.  */
+  virtual std::vector<std::string> GetKeepGoingBuildOptions() const
+  {
+    return std::vector<std::string>();
+  }
+
   /** Generate a "cmake --build" call for a given target and config.  */
   std::string GenerateCMakeBuildCommand(const std::string& target,
                                         const std::string& config,
@@ -270,6 +279,21 @@ public:
   std::vector<cmGeneratorTarget*> GetLocalGeneratorTargetsInOrder(
     cmLocalGenerator* lg) const;
 
+  /** Get the cache of generator expression results.  This is only
+      available while the build system is generated.  */
+  cmGeneratorExpressionEvaluationCache* GetGeneratorExpressionEvaluationCache()
+    const
+  {
+    return this->GeneratorExpressionEvaluationCache.get();
+  }
+
+  /** Get the cache of computed link dependencies.  This is only
+      available while the build system is generated.  */
+  cmComputeLinkDependsCache* GetComputeLinkDependsCache() const
+  {
+    return this->ComputeLinkDependsCache.get();
+  }
+
   cmMakefile* GetCurrentMakefile() const
   {
     return this->CurrentConfigureMakefile;
@@ -370,6 +394,14 @@ public:
   std::set<std::string> const& GetDirectoryContent(std::string const& dir,
                                                    bool needDisk = true);
 
+  /** Get the content of a directory as by GetDirectoryContent, with
+      names folded to lower case where the file system may be
+      case-insensitive.  Names to look up must be folded with
+      FoldDirectoryContentName.  */
+  std::set<std::string> const& GetFoldedDirectoryContent(
+    std::string const& dir);
+  static std::string FoldDirectoryContentName(std::string const& name);
+
   void IndexTarget(cmTarget* t);
   void IndexGeneratorTarget(cmGeneratorTarget* gt);
 
@@ -674,6 +706,10 @@ private:
 
   std::unique_ptr<cmExternalMakefileProjectGenerator> ExtraGenerator;
 
+  std::unique_ptr<cmGeneratorExpressionEvaluationCache>
+    GeneratorExpressionEvaluationCache;
+  std::unique_ptr<cmComputeLinkDependsCache> ComputeLinkDependsCache;
+
   // track files replaced during a Generate
   std::vector<std::string> FilesReplacedDuringGenerate;
 
@@ -706,6 +742,8 @@ private:
     long LastDiskTime = -1;
     std::set<std::string> All;
     std::set<std::string> Generated;
+    std::set<std::string> Folded;
+    bool FoldedValid = false;
   };
   std::map<std::string, DirectoryContent> DirectoryContentMap;
 
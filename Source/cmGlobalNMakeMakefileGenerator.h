@@ -54,6 +54,11 @@ protected:
 
   void PrintBuildCommandAdvice(std::ostream& os, int jobs) const override;
 
+  std::vector<std::string> GetKeepGoingBuildOptions() const override
+  {
+    return { "/K" };
+  }
+
 private:
   void PrintCompilerAdvice(std::ostream& os, std::string const& lang,
                            const char* envVar) const override;
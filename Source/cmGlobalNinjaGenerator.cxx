@@ -115,6 +115,9 @@ std::string cmGlobalNinjaGenerator::EncodeRuleName(std::string const& name)
 
 std::string cmGlobalNinjaGenerator::EncodeLiteral(const std::string& lit)
 {
+  if (lit.find_first_of("$\n") == std::string::npos) {
+    return lit;
+  }
   std::string result = lit;
   cmSystemTools::ReplaceString(result, "$", "$$");
   cmSystemTools::ReplaceString(result, "\n", "$\n");
@@ -135,6 +138,10 @@ std::string cmGlobalNinjaGenerator::EncodePath(const std::string& path)
   else
     std::replace(result.begin(), result.end(), '/', '\\');
 #endif
+  // Most paths contain nothing that needs to be escaped.
+  if (result.find_first_of("$\n :") == std::string::npos) {
+    return result;
+  }
   result = EncodeLiteral(result);
   cmSystemTools::ReplaceString(result, " ", "$ ");
   cmSystemTools::ReplaceString(result, ":", "$:");
@@ -167,7 +174,8 @@ void cmGlobalNinjaGenerator::WriteBuild(std::ostream& os,
   {
     // Write explicit outputs
     for (std::string const& output : build.Outputs) {
-      buildStr += cmStrCat(' ', EncodePath(output));
+      buildStr += ' ';
+      buildStr += EncodePath(output);
       if (this->ComputingUnknownDependencies) {
         this->CombinedBuildOutputs.insert(output);
       }
@@ -176,7 +184,8 @@ void cmGlobalNinjaGenerator::WriteBuild(std::ostream& os,
     if (!build.ImplicitOuts.empty()) {
       buildStr += " |";
       for (std::string const& implicitOut : build.ImplicitOuts) {
-        buildStr += cmStrCat(' ', EncodePath(implicitOut));
+        buildStr += ' ';
+        buildStr += EncodePath(implicitOut);
       }
     }
     buildStr += ':';
@@ -191,14 +200,16 @@ void cmGlobalNinjaGenerator::WriteBuild(std::ostream& os,
 
     // Write explicit dependencies.
     for (std::string const& explicitDep : build.ExplicitDeps) {
-      arguments += cmStrCat(' ', EncodePath(explicitDep));
+      arguments += ' ';
+      arguments += EncodePath(explicitDep);
     }
 
     // Write implicit dependencies.
     if (!build.ImplicitDeps.empty()) {
       arguments += " |";
       for (std::string const& implicitDep : build.ImplicitDeps) {
-        arguments += cmStrCat(' ', EncodePath(implicitDep));
+        arguments += ' ';
+        arguments += EncodePath(implicitDep);
       }
     }
 
@@ -206,7 +217,8 @@ void cmGlobalNinjaGenerator::WriteBuild(std::ostream& os,
     if (!build.OrderOnlyDeps.empty()) {
       arguments += " ||";
       for (std::string const& orderOnlyDep : build.OrderOnlyDeps) {
-        arguments += cmStrCat(' ', EncodePath(orderOnlyDep));
+        arguments += ' ';
+        arguments += EncodePath(orderOnlyDep);
       }
     }
 
@@ -186,6 +186,11 @@ public:
     std::vector<std::string> const& makeOptions =
       std::vector<std::string>()) override;
 
+  std::vector<std::string> GetKeepGoingBuildOptions() const override
+  {
+    return { "-k", "0" };
+  }
+
   // Setup target names
   const char* GetAllTargetName() const override { return "all"; }
   const char* GetInstallTargetName() const override { return "install"; }
@@ -149,6 +149,11 @@ public:
     std::vector<std::string> const& makeOptions =
       std::vector<std::string>()) override;
 
+  std::vector<std::string> GetKeepGoingBuildOptions() const override
+  {
+    return { "-k" };
+  }
+
   /** Record per-target progress information.  */
   void RecordTargetProgress(cmMakefileTargetGenerator* tg);
 
@@ -62,4 +62,9 @@ protected:
       std::vector<std::string>()) override;
 
   void PrintBuildCommandAdvice(std::ostream& os, int jobs) const override;
+
+  std::vector<std::string> GetKeepGoingBuildOptions() const override
+  {
+    return std::vector<std::string>();
+  }
 };
@@ -7,6 +7,8 @@
 #include <sstream>
 #include <utility>
 
+#include "cmsys/FStream.hxx"
+
 #include "cmListFileLexer.h"
 #include "cmMessageType.h"
 #include "cmMessenger.h"
@@ -25,6 +27,7 @@ struct cmListFileParser
   void IssueFileOpenError(std::string const& text) const;
   void IssueError(std::string const& text) const;
   bool ParseFile(const char* filename);
+  bool ParseBuffer(std::string const& content, const char* filename);
   bool ParseString(const char* str, const char* virtual_filename);
   bool Parse();
   bool ParseFunction(const char* name, long line);
@@ -45,6 +48,7 @@ struct cmListFileParser
     SeparationWarning,
     SeparationError
   } Separation;
+  bool IssuedWarning = false;
 };
 
 cmListFileParser::cmListFileParser(cmListFile* lf, cmListFileBacktrace lfbt,
@@ -108,6 +112,27 @@ bool cmListFileParser::ParseFile(const char* filename)
   return Parse();
 }
 
+bool cmListFileParser::ParseBuffer(std::string const& content,
+                                   const char* filename)
+{
+  this->FileName = filename;
+
+  // Scan the content in place, it has already been read.
+  cmListFileLexer_BOM bom;
+  cmListFileLexer_SetBuffer(this->Lexer, content.data(), content.size(),
+                            &bom);
+
+  // Verify the Byte-Order-Mark, if any.
+  if (bom != cmListFileLexer_BOM_None && bom != cmListFileLexer_BOM_UTF8) {
+    cmListFileLexer_SetBuffer(this->Lexer, nullptr, 0, nullptr);
+    this->IssueFileOpenError(
+      "File starts with a Byte-Order-Mark that is not UTF-8.");
+    return false;
+  }
+
+  return Parse();
+}
+
 bool cmListFileParser::ParseString(const char* str,
                                    const char* virtual_filename)
 {
@@ -191,6 +216,78 @@ bool cmListFile::ParseFile(const char* filename, cmMessenger* messenger,
   return !parseError;
 }
 
+bool cmListFileCache::ParseFile(cmListFile& listFile, std::string const& path,
+                                cmMessenger* messenger,
+                                cmListFileBacktrace const& lfbt)
+{
+  if (!cmSystemTools::FileExists(path) ||
+      cmSystemTools::FileIsDirectory(path)) {
+    return false;
+  }
+
+  // A file with the size and time it had when it was parsed still has
+  // the same content, so it is not read again.
+  cmFileTime mtime;
+  bool const haveTime = mtime.Load(path);
+  unsigned long const size = cmSystemTools::FileLength(path);
+  auto it = this->Entries.find(path);
+  if (haveTime && it != this->Entries.end() && it->second.Size == size &&
+      it->second.MTime.Equal(mtime)) {
+    ++this->Hits;
+    listFile.Functions = it->second.Functions;
+    return true;
+  }
+  ++this->Misses;
+
+  std::string content;
+  {
+    cmsys::ifstream fin(path.c_str(), std::ios::in | std::ios::binary);
+    if (!fin) {
+      messenger->IssueMessage(MessageType::FATAL_ERROR,
+                              "cmListFileCache: error can not open file.",
+                              lfbt);
+      return false;
+    }
+    // Reject input that cannot be read from the start again, such as a
+    // pipe, as the lexer does when it reads a file itself.
+    if (!fin.seekg(0, std::ios::beg)) {
+      messenger->IssueMessage(
+        MessageType::FATAL_ERROR,
+        "Error while reading Byte-Order-Mark. File not seekable?", lfbt);
+      return false;
+    }
+    std::ostringstream contentStream;
+    contentStream << fin.rdbuf();
+    content = contentStream.str();
+  }
+
+  // Parse the content read above instead of reading the file again.
+  cmListFileParser parser(&listFile, lfbt, messenger);
+  if (!parser.ParseBuffer(content, path.c_str())) {
+    return false;
+  }
+
+  // Warnings issued while parsing must be issued again by a later
+  // read of the same file, so do not remember such a parse.  A file
+  // written less than two seconds ago may be written again without a
+  // change of its time on file systems with a coarse time resolution.
+  cmFileTime now;
+  now.LoadNow();
+  if (parser.IssuedWarning || !haveTime ||
+      now.GetNS() - mtime.GetNS() < 2 * cmFileTime::NsPerS) {
+    if (it != this->Entries.end()) {
+      this->Entries.erase(it);
+    }
+    return true;
+  }
+
+  Entry& entry = this->Entries[path];
+  entry.Size = size;
+  entry.MTime = mtime;
+  entry.Functions = listFile.Functions;
+  return true;
+}
+
 bool cmListFile::ParseString(const char* str, const char* virtual_filename,
                              cmMessenger* messenger,
                              const cmListFileBacktrace& lfbt)
@@ -304,7 +401,8 @@ bool cmListFileParser::ParseFunction(const char* name, long line)
 bool cmListFileParser::AddArgument(cmListFileLexer_Token* token,
                                    cmListFileArgument::Delimiter delim)
 {
-  this->FunctionArguments.emplace_back(token->text, delim, token->line);
+  this->FunctionArguments.emplace_back(std::string(token->text, token->length),
+                                       delim, token->line);
   if (this->Separation == SeparationOkay) {
     return true;
   }
@@ -326,6 +424,7 @@ bool cmListFileParser::AddArgument(cmListFileLexer_Token* token,
     return false;
   }
   this->Messenger->IssueMessage(MessageType::AUTHOR_WARNING, m.str(), lfbt);
+  this->IssuedWarning = true;
   return true;
 }
 
@@ -8,21 +8,16 @@
 #include <iosfwd>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include <cm/optional>
 
+#include "cmFileTime.h"
 #include "cmStateSnapshot.h"
 #include "cmSystemTools.h"
 
-/** \class cmListFileCache
- * \brief A class to cache list file contents.
- *
- * cmListFileCache is a class used to cache the contents of parsed
- * cmake list files.
- */
-
 class cmMessenger;
 
 struct cmCommandContext
@@ -279,3 +274,35 @@ struct cmListFile
 
   std::vector<cmListFileFunction> Functions;
 };
+
+/** \class cmListFileCache
+ * \brief A class to cache list file contents.
+ *
+ * cmListFileCache is a class used to cache the contents of parsed
+ * cmake list files.  A file is parsed again if its size or modification
+ * time differs from the one it had when it was last parsed.  Files
+ * modified too recently for a later change to show in their time are
+ * not cached.  The cache is cleared before each configure step.
+ */
+class cmListFileCache
+{
+public:
+  bool ParseFile(cmListFile& listFile, std::string const& path,
+                 cmMessenger* messenger, cmListFileBacktrace const& lfbt);
+
+  void Clear() { this->Entries.clear(); }
+
+  unsigned long GetHits() const { return this->Hits; }
+  unsigned long GetMisses() const { return this->Misses; }
+
+private:
+  struct Entry
+  {
+    unsigned long Size = 0;
+    cmFileTime MTime;
+    std::vector<cmListFileFunction> Functions;
+  };
+  std::unordered_map<std::string, Entry> Entries;
+  unsigned long Hits = 0;
+  unsigned long Misses = 0;
+};
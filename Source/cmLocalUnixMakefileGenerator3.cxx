@@ -9,6 +9,7 @@
 #include <utility>
 
 #include <cm/memory>
+#include <cm/optional>
 #include <cm/vector>
 #include <cmext/algorithm>
 
@@ -18,6 +19,8 @@
 #include "cmCustomCommand.h" // IWYU pragma: keep
 #include "cmCustomCommandGenerator.h"
 #include "cmFileTimeCache.h"
+#include "cmGccDepfileReader.h"
+#include "cmGccDepfileReaderTypes.h"
 #include "cmGeneratedFileStream.h"
 #include "cmGeneratorExpression.h"
 #include "cmGeneratorTarget.h"
@@ -1302,6 +1305,12 @@ bool cmLocalUnixMakefileGenerator3::UpdateDependencies(
   this->CheckMultipleOutputs(verbose);
 
   std::string const targetDir = cmSystemTools::GetFilenamePath(tgtInfo);
+
+  // Merge the dependency files written by the compiler, if any.
+  if (!this->UpdateCompilerDependencies(targetDir, tgtInfo, verbose)) {
+    return false;
+  }
+
   std::string const internalDependFile = targetDir + "/depend.internal";
   std::string const dependFile = targetDir + "/depend.make";
 
@@ -1324,6 +1333,20 @@ bool cmLocalUnixMakefileGenerator3::UpdateDependencies(
     }
   }
 
+  // The build tool re-runs this step only if a file listed as a dependency
+  // of the stamp changes.  Scan again if the files were never listed.
+  bool const useDependStamp =
+    this->Makefile->IsOn("CMAKE_DEPENDS_SKIP_UNCHANGED");
+  std::string const dependStamp = cmStrCat(targetDir, "/depend.ts");
+  if (useDependStamp && !needRescanDependInfo &&
+      !cmSystemTools::FileExists(dependStamp)) {
+    if (verbose) {
+      cmSystemTools::Stdout(
+        cmStrCat("Dependencies stamp \"", dependStamp, "\" is missing.\n"));
+    }
+    needRescanDependInfo = true;
+  }
+
   // If the directory information is newer than depend.internal, include dirs
   // may have changed. In this case discard all old dependencies.
   bool needRescanDirInfo = false;
@@ -1368,20 +1391,31 @@ bool cmLocalUnixMakefileGenerator3::UpdateDependencies(
   }
 
   if (needRescanDependInfo || needRescanDirInfo || needRescanDependencies) {
-    // The dependencies must be regenerated.
-    std::string targetName = cmSystemTools::GetFilenameName(targetDir);
-    targetName = targetName.substr(0, targetName.length() - 4);
-    std::string message =
-      cmStrCat("Scanning dependencies of target ", targetName);
-    cmSystemTools::MakefileColorEcho(cmsysTerminal_Color_ForegroundMagenta |
-                                       cmsysTerminal_Color_ForegroundBold,
-                                     message.c_str(), true, color);
+    // The dependencies must be regenerated.  Nothing is scanned if the
+    // compiler provides the dependencies of all languages.
+    if (!this->Makefile->IsSet("CMAKE_DEPENDS_DEPENDENCY_FILES") ||
+        cmNonempty(this->Makefile->GetDefinition("CMAKE_DEPENDS_LANGUAGES"))) {
+      std::string targetName = cmSystemTools::GetFilenameName(targetDir);
+      targetName = targetName.substr(0, targetName.length() - 4);
+      std::string message =
+        cmStrCat("Scanning dependencies of target ", targetName);
+      cmSystemTools::MakefileColorEcho(
+        cmsysTerminal_Color_ForegroundMagenta |
+          cmsysTerminal_Color_ForegroundBold,
+        message.c_str(), true, color);
+    }
 
-    return this->ScanDependencies(targetDir, dependFile, internalDependFile,
-                                  validDependencies);
+    if (!this->ScanDependencies(targetDir, dependFile, internalDependFile,
+                                validDependencies)) {
+      return false;
+    }
   }
 
-  // The dependencies are already up-to-date.
+  // The dependencies are up-to-date.  Tell the build tool when they
+  // were checked so it can skip this step until an input changes.
+  if (useDependStamp) {
+    return cmSystemTools::Touch(dependStamp, true);
+  }
   return true;
 }
 
@@ -1391,40 +1425,7 @@ bool cmLocalUnixMakefileGenerator3::ScanDependencies(
 {
   // Read the directory information file.
   cmMakefile* mf = this->Makefile;
-  bool haveDirectoryInfo = false;
-  {
-    std::string dirInfoFile =
-      cmStrCat(this->GetCurrentBinaryDirectory(),
-               "/CMakeFiles/CMakeDirectoryInformation.cmake");
-    if (mf->ReadListFile(dirInfoFile) &&
-        !cmSystemTools::GetErrorOccuredFlag()) {
-      haveDirectoryInfo = true;
-    }
-  }
-
-  // Lookup useful directory information.
-  if (haveDirectoryInfo) {
-    // Test whether we need to force Unix paths.
-    if (cmProp force = mf->GetDefinition("CMAKE_FORCE_UNIX_PATHS")) {
-      if (!cmIsOff(force)) {
-        cmSystemTools::SetForceUnixPaths(true);
-      }
-    }
-
-    // Setup relative path top directories.
-    if (cmProp relativePathTopSource =
-          mf->GetDefinition("CMAKE_RELATIVE_PATH_TOP_SOURCE")) {
-      this->StateSnapshot.GetDirectory().SetRelativePathTopSource(
-        relativePathTopSource->c_str());
-    }
-    if (cmProp relativePathTopBinary =
-          mf->GetDefinition("CMAKE_RELATIVE_PATH_TOP_BINARY")) {
-      this->StateSnapshot.GetDirectory().SetRelativePathTopBinary(
-        relativePathTopBinary->c_str());
-    }
-  } else {
-    cmSystemTools::Error("Directory Information file not found");
-  }
+  this->ReadDirectoryInformation();
 
   // Open the make depends file.  This should be copy-if-different
   // because the make tool may try to reload it needlessly otherwise.
@@ -1454,9 +1455,7 @@ bool cmLocalUnixMakefileGenerator3::ScanDependencies(
     // construct the checker
     // Create the scanner for this language
     std::unique_ptr<cmDepends> scanner;
-    if (lang == "C" || lang == "CXX" || lang == "RC" || lang == "ASM" ||
-        lang == "OBJC" || lang == "OBJCXX" || lang == "CUDA" ||
-        lang == "ISPC") {
+    if (cmDependsC::IsScannedLanguage(lang)) {
       // TODO: Handle RC (resource files) dependencies correctly.
       scanner = cm::make_unique<cmDependsC>(this, targetDir, lang, &validDeps);
     }
@@ -1483,6 +1482,152 @@ bool cmLocalUnixMakefileGenerator3::ScanDependencies(
   return true;
 }
 
+bool cmLocalUnixMakefileGenerator3::UpdateCompilerDependencies(
+  std::string const& targetDir, std::string const& tgtInfo, bool verbose)
+{
+  cmMakefile* mf = this->Makefile;
+
+  // Get the pairs of object and dependency file written by the compiler.
+  cmProp pairs_string = mf->GetDefinition("CMAKE_DEPENDS_DEPENDENCY_FILES");
+  if (!pairs_string) {
+    return true;
+  }
+  std::vector<std::string> pairs = cmExpandedList(*pairs_string, true);
+
+  // The merged dependencies are up to date if the stamp file is newer
+  // than the target information and every dependency file.
+  std::string const compilerDependFile =
+    cmStrCat(targetDir, "/compiler_depend.make");
+  std::string const compilerDependStamp =
+    cmStrCat(targetDir, "/compiler_depend.ts");
+  cmFileTimeCache* ftc =
+    this->GlobalGenerator->GetCMakeInstance()->GetFileTimeCache();
+  auto isNewer = [&](std::string const& dependee) -> bool {
+    int result;
+    if (!ftc->Compare(compilerDependStamp, dependee, &result) || result < 0) {
+      if (verbose) {
+        cmSystemTools::Stdout(cmStrCat("Dependee \"", dependee,
+                                       "\" is newer than depender \"",
+                                       compilerDependStamp, "\".\n"));
+      }
+      return true;
+    }
+    return false;
+  };
+  bool needMerge = isNewer(tgtInfo);
+  for (auto i = pairs.begin();
+       !needMerge && i != pairs.end() && (i + 1) != pairs.end(); i += 2) {
+    std::string const& depFile = *(i + 1);
+    needMerge = cmSystemTools::FileExists(depFile) && isNewer(depFile);
+  }
+  if (!needMerge) {
+    return true;
+  }
+
+  // Relative paths must be computed as the generator did.
+  this->ReadDirectoryInformation();
+  std::string const& binDir = this->GetBinaryDirectory();
+  std::string const& currentBinDir = this->GetCurrentBinaryDirectory();
+
+  // Open the compiler dependencies file.  This should be
+  // copy-if-different because the make tool may try to reload it
+  // needlessly otherwise.
+  cmGeneratedFileStream ruleFileStream(
+    compilerDependFile, false, this->GlobalGenerator->GetMakefileEncoding());
+  ruleFileStream.SetCopyIfDifferent(true);
+  if (!ruleFileStream) {
+    return false;
+  }
+  this->WriteDisclaimer(ruleFileStream);
+
+  std::set<std::string> allDeps;
+  for (auto i = pairs.begin(); i != pairs.end() && (i + 1) != pairs.end();) {
+    std::string const& obj = *i++;
+    std::string const& depFile = *i++;
+
+    // The object has not been compiled yet.
+    if (!cmSystemTools::FileExists(depFile)) {
+      continue;
+    }
+
+    cm::optional<cmGccDepfileContent> content =
+      cmReadGccDepfile(depFile.c_str());
+    if (!content) {
+      if (verbose) {
+        cmSystemTools::Stdout(
+          cmStrCat("Ignoring malformed dependency file \"", depFile, "\".\n"));
+      }
+      continue;
+    }
+
+    // The compiler ran in the directory of the target.
+    std::set<std::string> deps;
+    for (cmGccStyleDependency const& dep : *content) {
+      for (std::string const& path : dep.paths) {
+        deps.insert(cmSystemTools::CollapseFullPath(path, currentBinDir));
+      }
+    }
+
+    std::string const obj_m = this->ConvertToMakefilePath(
+      this->MaybeConvertToRelativePath(binDir, obj));
+    for (std::string const& dep : deps) {
+      std::string dep_m = this->ConvertToMakefilePath(
+        this->MaybeConvertToRelativePath(binDir, dep));
+      ruleFileStream << obj_m << ": " << dep_m << '\n';
+      allDeps.insert(std::move(dep_m));
+    }
+    ruleFileStream << '\n';
+  }
+
+  // Do not fail the build when a dependency has been removed.
+  if (!allDeps.empty()) {
+    ruleFileStream << '\n';
+    for (std::string const& dep : allDeps) {
+      ruleFileStream << dep << ":\n";
+    }
+  }
+
+  // Record that the dependencies are now up to date.  The depends file
+  // itself is not touched when its content did not change.
+  if (!ruleFileStream) {
+    return false;
+  }
+  ruleFileStream.Close();
+  return cmSystemTools::Touch(compilerDependStamp, true);
+}
+
+bool cmLocalUnixMakefileGenerator3::ReadDirectoryInformation()
+{
+  cmMakefile* mf = this->Makefile;
+  std::string dirInfoFile =
+    cmStrCat(this->GetCurrentBinaryDirectory(),
+             "/CMakeFiles/CMakeDirectoryInformation.cmake");
+  if (!mf->ReadListFile(dirInfoFile) || cmSystemTools::GetErrorOccuredFlag()) {
+    cmSystemTools::Error("Directory Information file not found");
+    return false;
+  }
+
+  // Test whether we need to force Unix paths.
+  if (cmProp force = mf->GetDefinition("CMAKE_FORCE_UNIX_PATHS")) {
+    if (!cmIsOff(force)) {
+      cmSystemTools::SetForceUnixPaths(true);
+    }
+  }
+
+  // Setup relative path top directories.
+  if (cmProp relativePathTopSource =
+        mf->GetDefinition("CMAKE_RELATIVE_PATH_TOP_SOURCE")) {
+    this->StateSnapshot.GetDirectory().SetRelativePathTopSource(
+      relativePathTopSource->c_str());
+  }
+  if (cmProp relativePathTopBinary =
+        mf->GetDefinition("CMAKE_RELATIVE_PATH_TOP_BINARY")) {
+    this->StateSnapshot.GetDirectory().SetRelativePathTopBinary(
+      relativePathTopBinary->c_str());
+  }
+  return true;
+}
+
 void cmLocalUnixMakefileGenerator3::CheckMultipleOutputs(bool verbose)
 {
   cmMakefile* mf = this->Makefile;
@@ -1731,6 +1876,16 @@ void cmLocalUnixMakefileGenerator3::ClearDependencies(cmMakefile* mf,
     // regeneration.
     std::string internalDependFile = dir + "/depend.internal";
     cmSystemTools::RemoveFile(internalDependFile);
+
+    // Remove the stamp file to force checking dependencies again.
+    cmSystemTools::RemoveFile(dir + "/depend.ts");
+
+    // Clear the dependencies written by the compiler, if any.
+    std::string compilerDependStamp = dir + "/compiler_depend.ts";
+    if (cmSystemTools::FileExists(compilerDependStamp)) {
+      clearer.Clear(dir + "/compiler_depend.make");
+      cmSystemTools::RemoveFile(compilerDependStamp);
+    }
   }
 }
 
@@ -243,6 +243,9 @@ protected:
                         std::string const& dependFile,
                         std::string const& internalDependFile,
                         cmDepends::DependencyMap& validDeps);
+  bool UpdateCompilerDependencies(std::string const& targetDir,
+                                  std::string const& tgtInfo, bool verbose);
+  bool ReadDirectoryInformation();
   void CheckMultipleOutputs(bool verbose);
 
 private:
@@ -2,7 +2,10 @@
    file Copyright.txt or https://cmake.org/licensing for details.  */
 #include "cmMacroCommand.h"
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdio>
+#include <memory>
 #include <utility>
 
 #include <cm/memory>
@@ -33,17 +36,33 @@ public:
   bool operator()(std::vector<cmListFileArgument> const& args,
                   cmExecutionStatus& inStatus) const;
 
-  std::vector<std::string> Args;
-  std::vector<cmListFileFunction> Functions;
-  cmPolicies::PolicyMap Policies;
-  std::string FilePath;
+  // The command is copied each time it is looked up for invocation,
+  // so share the recorded definition among all copies.
+  struct Definition
+  {
+    std::vector<std::string> Args;
+    std::vector<cmListFileFunction> Functions;
+    // Whether each function has an argument that may reference a
+    // formal argument.  Other functions are invoked unchanged.
+    std::vector<bool> NeedsReplacement;
+    cmPolicies::PolicyMap Policies;
+    std::string FilePath;
+  };
+  std::shared_ptr<Definition const> Def;
 };
 
+bool MayReferenceArguments(cmListFileArgument const& arg)
+{
+  return arg.Delim != cmListFileArgument::Bracket &&
+    arg.Value.find("${") != std::string::npos;
+}
+
 bool cmMacroHelperCommand::operator()(
   std::vector<cmListFileArgument> const& args,
   cmExecutionStatus& inStatus) const
 {
   cmMakefile& makefile = inStatus.GetMakefile();
+  Definition const& def = *this->Def;
 
   // Expand the argument list to the macro.
   std::vector<std::string> expandedArgs;
@@ -51,27 +70,27 @@ bool cmMacroHelperCommand::operator()(
 
   // make sure the number of arguments passed is at least the number
   // required by the signature
-  if (expandedArgs.size() < this->Args.size() - 1) {
+  if (expandedArgs.size() < def.Args.size() - 1) {
     std::string errorMsg =
       cmStrCat("Macro invoked with incorrect arguments for macro named: ",
-               this->Args[0]);
+               def.Args[0]);
     inStatus.SetError(errorMsg);
     return false;
   }
 
-  cmMakefile::MacroPushPop macroScope(&makefile, this->FilePath,
-                                      this->Policies);
+  cmMakefile::MacroPushPop macroScope(&makefile, def.FilePath,
+                                      def.Policies);
 
   // set the value of argc
   std::string argcDef = std::to_string(expandedArgs.size());
 
-  auto eit = expandedArgs.begin() + (this->Args.size() - 1);
+  auto eit = expandedArgs.begin() + (def.Args.size() - 1);
   std::string expandedArgn = cmJoin(cmMakeRange(eit, expandedArgs.end()), ";");
   std::string expandedArgv = cmJoin(expandedArgs, ";");
   std::vector<std::string> variables;
-  variables.reserve(this->Args.size() - 1);
-  for (unsigned int j = 1; j < this->Args.size(); ++j) {
-    variables.push_back("${" + this->Args[j] + "}");
+  variables.reserve(def.Args.size() - 1);
+  for (unsigned int j = 1; j < def.Args.size(); ++j) {
+    variables.push_back("${" + def.Args[j] + "}");
   }
   std::vector<std::string> argVs;
   argVs.reserve(expandedArgs.size());
@@ -82,41 +101,45 @@ bool cmMacroHelperCommand::operator()(
   }
   // Invoke all the functions that were collected in the block.
   // for each function
-  for (cmListFileFunction const& func : this->Functions) {
-    // Replace the formal arguments and then invoke the command.
-    std::vector<cmListFileArgument> newLFFArgs;
-    newLFFArgs.reserve(func.Arguments().size());
-
-    // for each argument of the current function
-    for (cmListFileArgument const& k : func.Arguments()) {
-      cmListFileArgument arg;
-      arg.Value = k.Value;
-      if (k.Delim != cmListFileArgument::Bracket) {
-        // replace formal arguments
-        for (unsigned int j = 0; j < variables.size(); ++j) {
-          cmSystemTools::ReplaceString(arg.Value, variables[j],
-                                       expandedArgs[j]);
-        }
-        // replace argc
-        cmSystemTools::ReplaceString(arg.Value, "${ARGC}", argcDef);
-
-        cmSystemTools::ReplaceString(arg.Value, "${ARGN}", expandedArgn);
-        cmSystemTools::ReplaceString(arg.Value, "${ARGV}", expandedArgv);
-
-        // if the current argument of the current function has ${ARGV in it
-        // then try replacing ARGV values
-        if (arg.Value.find("${ARGV") != std::string::npos) {
-          for (unsigned int t = 0; t < expandedArgs.size(); ++t) {
-            cmSystemTools::ReplaceString(arg.Value, argVs[t], expandedArgs[t]);
+  for (std::size_t i = 0; i < def.Functions.size(); ++i) {
+    cmListFileFunction newLFF = def.Functions[i];
+    if (def.NeedsReplacement[i]) {
+      // Replace the formal arguments and then invoke the command.
+      std::vector<cmListFileArgument> newLFFArgs;
+      newLFFArgs.reserve(newLFF.Arguments().size());
+
+      // for each argument of the current function
+      for (cmListFileArgument const& k : newLFF.Arguments()) {
+        cmListFileArgument arg;
+        arg.Value = k.Value;
+        if (MayReferenceArguments(k)) {
+          // replace formal arguments
+          for (unsigned int j = 0; j < variables.size(); ++j) {
+            cmSystemTools::ReplaceString(arg.Value, variables[j],
+                                         expandedArgs[j]);
+          }
+          // replace argc
+          cmSystemTools::ReplaceString(arg.Value, "${ARGC}", argcDef);
+
+          cmSystemTools::ReplaceString(arg.Value, "${ARGN}", expandedArgn);
+          cmSystemTools::ReplaceString(arg.Value, "${ARGV}", expandedArgv);
+
+          // if the current argument of the current function has ${ARGV in
+          // it then try replacing ARGV values
+          if (arg.Value.find("${ARGV") != std::string::npos) {
+            for (unsigned int t = 0; t < expandedArgs.size(); ++t) {
+              cmSystemTools::ReplaceString(arg.Value, argVs[t],
+                                           expandedArgs[t]);
+            }
           }
         }
+        arg.Delim = k.Delim;
+        arg.Line = k.Line;
+        newLFFArgs.push_back(std::move(arg));
       }
-      arg.Delim = k.Delim;
-      arg.Line = k.Line;
-      newLFFArgs.push_back(std::move(arg));
+      newLFF = cmListFileFunction{ newLFF.OriginalName(), newLFF.Line(),
+                                   std::move(newLFFArgs) };
     }
-    cmListFileFunction newLFF{ func.OriginalName(), func.Line(),
-                               std::move(newLFFArgs) };
     cmExecutionStatus status(makefile);
     if (!makefile.ExecuteCommand(newLFF, status) || status.GetNestedError()) {
       // The error message should have already included the call stack
@@ -166,11 +189,19 @@ bool cmMacroFunctionBlocker::Replay(std::vector<cmListFileFunction> functions,
   cmMakefile& mf = status.GetMakefile();
   mf.AppendProperty("MACROS", this->Args[0]);
   // create a new command and add it to cmake
+  auto def = std::make_shared<cmMacroHelperCommand::Definition>();
+  def->Args = this->Args;
+  def->Functions = std::move(functions);
+  def->NeedsReplacement.reserve(def->Functions.size());
+  for (cmListFileFunction const& func : def->Functions) {
+    def->NeedsReplacement.push_back(std::any_of(func.Arguments().begin(),
+                                                func.Arguments().end(),
+                                                MayReferenceArguments));
+  }
+  def->FilePath = this->GetStartingContext().FilePath;
+  mf.RecordPolicies(def->Policies);
   cmMacroHelperCommand f;
-  f.Args = this->Args;
-  f.Functions = std::move(functions);
-  f.FilePath = this->GetStartingContext().FilePath;
-  mf.RecordPolicies(f.Policies);
+  f.Def = std::move(def);
   return mf.GetState()->AddScriptedCommand(
     this->Args[0],
     BT<cmState::Command>(std::move(f),
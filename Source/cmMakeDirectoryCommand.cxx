@@ -3,7 +3,9 @@
 #include "cmMakeDirectoryCommand.h"
 
 #include "cmExecutionStatus.h"
+#include "cmFileSystemCache.h"
 #include "cmMakefile.h"
+#include "cmState.h"
 #include "cmSystemTools.h"
 
 // cmMakeDirectoryCommand
@@ -22,5 +24,6 @@ bool cmMakeDirectoryCommand(std::vector<std::string> const& args,
     return false;
   }
   cmSystemTools::MakeDirectory(args[0]);
+  status.GetMakefile().GetState()->GetFileSystemCache().Invalidate(args[0]);
   return true;
 }
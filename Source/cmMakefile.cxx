@@ -39,6 +39,7 @@
 #include "cmExportBuildFileGenerator.h"
 #include "cmFSPermissions.h"
 #include "cmFileLockPool.h"
+#include "cmFileSystemCache.h"
 #include "cmFunctionBlocker.h"
 #include "cmGeneratedFileStream.h"
 #include "cmGeneratorExpression.h"
@@ -628,8 +629,7 @@ bool cmMakefile::ReadDependentFile(const std::string& filename,
   IncludeScope incScope(this, filenametoread, noPolicyScope);
 
   cmListFile listFile;
-  if (!listFile.ParseFile(filenametoread.c_str(), this->GetMessenger(),
-                          this->Backtrace)) {
+  if (!this->ParseListFile(listFile, filenametoread)) {
     return false;
   }
 
@@ -729,8 +729,7 @@ bool cmMakefile::ReadListFile(const std::string& filename)
   ListFileScope scope(this, filenametoread);
 
   cmListFile listFile;
-  if (!listFile.ParseFile(filenametoread.c_str(), this->GetMessenger(),
-                          this->Backtrace)) {
+  if (!this->ParseListFile(listFile, filenametoread)) {
     return false;
   }
 
@@ -741,6 +740,24 @@ bool cmMakefile::ReadListFile(const std::string& filename)
   return true;
 }
 
+bool cmMakefile::ParseListFile(cmListFile& listFile,
+                               std::string const& filename)
+{
+  cmListFileCache& cache = this->GetState()->GetListFileCache();
+  bool result =
+    cache.ParseFile(listFile, filename, this->GetMessenger(), this->Backtrace);
+#if !defined(CMAKE_BOOTSTRAP)
+  if (this->GetCMakeInstance()->IsProfilingEnabled()) {
+    Json::Value counters;
+    counters["hits"] = Json::Value::UInt64(cache.GetHits());
+    counters["misses"] = Json::Value::UInt64(cache.GetMisses());
+    this->GetCMakeInstance()->GetProfilingOutput().CounterEntry(
+      "listfile cache", counters);
+  }
+#endif
+  return result;
+}
+
 bool cmMakefile::ReadListFileAsString(const std::string& content,
                                       const std::string& virtualFileName)
 {
@@ -1673,8 +1690,7 @@ void cmMakefile::Configure()
   this->AddDefinition("CMAKE_PARENT_LIST_FILE", currentStart);
 
   cmListFile listFile;
-  if (!listFile.ParseFile(currentStart.c_str(), this->GetMessenger(),
-                          this->Backtrace)) {
+  if (!this->ParseListFile(listFile, currentStart)) {
     return;
   }
   if (this->IsRootMakefile()) {
@@ -2600,6 +2616,11 @@ const std::string& cmMakefile::ExpandVariablesInString(
   std::string& source, bool escapeQuotes, bool noEscapes, bool atOnly,
   const char* filename, long line, bool removeEmpty, bool replaceAt) const
 {
+  // A string without references or escapes expands to itself.
+  if (!cmMakefile::MayNeedExpansion(source)) {
+    return source;
+  }
+
   bool compareResults = false;
   MessageType mtype = MessageType::LOG;
   std::string errorstr;
@@ -3273,6 +3294,11 @@ bool cmMakefile::IsLoopBlock() const
   return !this->LoopBlockCounter.empty() && this->LoopBlockCounter.top() > 0;
 }
 
+bool cmMakefile::MayNeedExpansion(std::string const& value)
+{
+  return value.find_first_of("$@\\") != std::string::npos;
+}
+
 bool cmMakefile::ExpandArguments(std::vector<cmListFileArgument> const& inArgs,
                                  std::vector<std::string>& outArgs) const
 {
@@ -3285,17 +3311,22 @@ bool cmMakefile::ExpandArguments(std::vector<cmListFileArgument> const& inArgs,
       outArgs.push_back(i.Value);
       continue;
     }
-    // Expand the variables in the argument.
-    value = i.Value;
-    this->ExpandVariablesInString(value, false, false, false, filename.c_str(),
-                                  i.Line, false, false);
+    // No expansion in an argument without references or escapes.
+    std::string const* expanded = &i.Value;
+    if (cmMakefile::MayNeedExpansion(i.Value)) {
+      // Expand the variables in the argument.
+      value = i.Value;
+      this->ExpandVariablesInString(value, false, false, false,
+                                    filename.c_str(), i.Line, false, false);
+      expanded = &value;
+    }
 
     // If the argument is quoted, it should be one argument.
     // Otherwise, it may be a list of arguments.
     if (i.Delim == cmListFileArgument::Quoted) {
-      outArgs.push_back(value);
+      outArgs.push_back(*expanded);
     } else {
-      cmExpandList(value, outArgs);
+      cmExpandList(*expanded, outArgs);
     }
   }
   return !cmSystemTools::GetFatalErrorOccured();
@@ -3314,17 +3345,22 @@ bool cmMakefile::ExpandArguments(
       outArgs.emplace_back(i.Value, true);
       continue;
     }
-    // Expand the variables in the argument.
-    value = i.Value;
-    this->ExpandVariablesInString(value, false, false, false, filename.c_str(),
-                                  i.Line, false, false);
+    // No expansion in an argument without references or escapes.
+    std::string const* expanded = &i.Value;
+    if (cmMakefile::MayNeedExpansion(i.Value)) {
+      // Expand the variables in the argument.
+      value = i.Value;
+      this->ExpandVariablesInString(value, false, false, false,
+                                    filename.c_str(), i.Line, false, false);
+      expanded = &value;
+    }
 
     // If the argument is quoted, it should be one argument.
     // Otherwise, it may be a list of arguments.
     if (i.Delim == cmListFileArgument::Quoted) {
-      outArgs.emplace_back(value, true);
+      outArgs.emplace_back(*expanded, true);
     } else {
-      std::vector<std::string> stringArgs = cmExpandedList(value);
+      std::vector<std::string> stringArgs = cmExpandedList(*expanded);
       for (std::string const& stringArg : stringArgs) {
         outArgs.emplace_back(stringArg, false);
       }
@@ -3399,16 +3435,70 @@ cmSourceFile* cmMakefile::GetSource(const std::string& sourceName,
   name = cmSystemTools::LowerCase(name);
 #endif
   auto sfsi = this->SourceFileSearchIndex.find(name);
-  if (sfsi != this->SourceFileSearchIndex.end()) {
-    for (auto sf : sfsi->second) {
-      if (sf->Matches(sfl)) {
-        return sf;
+  if (sfsi == this->SourceFileSearchIndex.end()) {
+    return nullptr;
+  }
+
+  if (!sfl.ExtensionIsAmbiguous()) {
+    // Sources with a known location match only by full path.  Find the
+    // first of them, and then check the ambiguous sources before it.
+    SourceFileIndexEntry found(sfsi->second.size(), nullptr);
+    auto findExact = [this, &sfl, &found](std::string const& dir) {
+      auto esi = this->ExactSourceFileSearchIndex.find(
+        GetExactSourceFileKey(dir, sfl.GetName()));
+      if (esi == this->ExactSourceFileSearchIndex.end()) {
+        return;
+      }
+      for (SourceFileIndexEntry const& entry : esi->second) {
+        if (entry.first >= found.first) {
+          break;
+        }
+        if (entry.second->Matches(sfl)) {
+          found = entry;
+          break;
+        }
+      }
+    };
+    if (sfl.DirectoryIsAmbiguous()) {
+      findExact(cmSystemTools::CollapseFullPath(
+        sfl.GetDirectory(), this->GetCurrentSourceDirectory()));
+      findExact(cmSystemTools::CollapseFullPath(
+        sfl.GetDirectory(), this->GetCurrentBinaryDirectory()));
+    } else {
+      findExact(sfl.GetDirectory());
+    }
+    auto asi = this->AmbiguousSourceFileSearchIndex.find(name);
+    if (asi != this->AmbiguousSourceFileSearchIndex.end()) {
+      for (SourceFileIndexEntry const& entry : asi->second) {
+        if (entry.first >= found.first) {
+          break;
+        }
+        if (entry.second->Matches(sfl)) {
+          return entry.second;
+        }
       }
     }
+    return found.second;
+  }
+
+  for (auto sf : sfsi->second) {
+    if (sf->Matches(sfl)) {
+      return sf;
+    }
   }
   return nullptr;
 }
 
+std::string cmMakefile::GetExactSourceFileKey(std::string const& dir,
+                                              std::string const& name)
+{
+#if defined(_WIN32) || defined(__APPLE__)
+  return cmSystemTools::LowerCase(cmStrCat(dir, '/', name));
+#else
+  return cmStrCat(dir, '/', name);
+#endif
+}
+
 cmSourceFile* cmMakefile::CreateSource(const std::string& sourceName,
                                        bool generated,
                                        cmSourceFileLocationKind kind)
@@ -3423,7 +3513,17 @@ cmSourceFile* cmMakefile::CreateSource(const std::string& sourceName,
 #if defined(_WIN32) || defined(__APPLE__)
   name = cmSystemTools::LowerCase(name);
 #endif
-  this->SourceFileSearchIndex[name].push_back(sf.get());
+  std::vector<cmSourceFile*>& sfsi = this->SourceFileSearchIndex[name];
+  SourceFileIndexEntry entry(sfsi.size(), sf.get());
+  sfsi.push_back(sf.get());
+  cmSourceFileLocation const& sfl = sf->GetLocation();
+  if (!sfl.DirectoryIsAmbiguous() && !sfl.ExtensionIsAmbiguous()) {
+    this->ExactSourceFileSearchIndex[GetExactSourceFileKey(
+                                       sfl.GetDirectory(), sfl.GetName())]
+      .push_back(entry);
+  } else {
+    this->AmbiguousSourceFileSearchIndex[name].push_back(entry);
+  }
   // for "Known" paths add direct lookup (used for faster lookup in GetSource)
   if (kind == cmSourceFileLocationKind::Known) {
     this->KnownFileSearchIndex[sourceName] = sf.get();
@@ -3511,7 +3611,8 @@ void cmMakefile::EnableLanguage(std::vector<std::string> const& lang,
 int cmMakefile::TryCompile(const std::string& srcdir,
                            const std::string& bindir,
                            const std::string& projectName,
-                           const std::string& targetName, bool fast, int jobs,
+                           std::vector<std::string> const& targetNames,
+                           bool fast, int jobs,
                            const std::vector<std::string>* cmakeArgs,
                            std::string& output)
 {
@@ -3630,7 +3731,7 @@ int cmMakefile::TryCompile(const std::string& srcdir,
 
   // finally call the generator to actually build the resulting project
   int ret = this->GetGlobalGenerator()->TryCompile(
-    jobs, srcdir, bindir, projectName, targetName, fast, output, this);
+    jobs, srcdir, bindir, projectName, targetNames, fast, output, this);
 
   this->IsSourceFileTryCompile = false;
   return ret;
@@ -3872,6 +3973,7 @@ int cmMakefile::ConfigureFile(const std::string& infile,
   // when we finalize the configuration we will remove all
   // output files that now don't exist.
   this->AddCMakeOutputFile(soutfile);
+  this->GetState()->GetFileSystemCache().Invalidate(soutfile);
 
   mode_t perm = 0;
   if (!use_source_permissions) {
@@ -13,6 +13,7 @@
 #include <stack>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include <cm/optional>
@@ -125,8 +126,9 @@ public:
    * loaded commands, not as part of the usual build process.
    */
   int TryCompile(const std::string& srcdir, const std::string& bindir,
-                 const std::string& projectName, const std::string& targetName,
-                 bool fast, int jobs,
+                 const std::string& projectName,
+                 std::vector<std::string> const& targetNames, bool fast,
+                 int jobs,
                  const std::vector<std::string>* cmakeArgs,
                  std::string& output);
 
@@ -959,6 +961,22 @@ protected:
   // For "Known" paths we can store a direct filename to cmSourceFile map
   std::unordered_map<std::string, cmSourceFile*> KnownFileSearchIndex;
 
+  // A cmSourceFile whose directory and extension are both known when it
+  // is created keeps its location, so lookups with a known extension can
+  // find it by full path.  Each entry is stored with its position in the
+  // SourceFileSearchIndex list so that earlier cmSourceFiles whose
+  // location was ambiguous, which are kept in a separate list, still
+  // take precedence.  On platforms which have a case-insensitive
+  // filesystem the full path is stored in all lowercase, and candidates
+  // are confirmed with cmSourceFileLocation::Matches().
+  using SourceFileIndexEntry = std::pair<std::size_t, cmSourceFile*>;
+  std::unordered_map<std::string, std::vector<SourceFileIndexEntry>>
+    ExactSourceFileSearchIndex;
+  std::unordered_map<std::string, std::vector<SourceFileIndexEntry>>
+    AmbiguousSourceFileSearchIndex;
+  static std::string GetExactSourceFileKey(std::string const& dir,
+                                           std::string const& name);
+
   // Tests
   std::map<std::string, std::unique_ptr<cmTest>> Tests;
 
@@ -1008,6 +1026,8 @@ private:
 
   void DoGenerate(cmLocalGenerator& lg);
 
+  bool ParseListFile(cmListFile& listFile, std::string const& filename);
+
   void RunListFile(cmListFile const& listFile,
                    const std::string& filenametoread,
                    DeferCommands* defer = nullptr);
@@ -1070,6 +1090,8 @@ private:
   class BuildsystemFileScope;
   friend class BuildsystemFileScope;
 
+  // Whether a string may contain references or escapes to expand.
+  static bool MayNeedExpansion(std::string const& value);
   // CMP0053 == old
   MessageType ExpandVariablesInStringOld(std::string& errorstr,
                                          std::string& source,
@@ -4,8 +4,11 @@
 
 #include <chrono>
 #include <stdexcept>
+#include <utility>
 #include <vector>
 
+#include <cm/memory>
+
 #include <cm3p/json/value.h>
 #include <cm3p/json/writer.h>
 
@@ -17,7 +20,8 @@
 #include "cmSystemTools.h"
 
 cmMakefileProfilingData::cmMakefileProfilingData(
-  const std::string& profileStream)
+  const std::string& profileStream, Format format)
+  : OutputFormat(format)
 {
   std::ios::openmode omode = std::ios::out | std::ios::trunc;
   this->ProfileStream.open(profileStream.c_str(), omode);
@@ -28,6 +32,11 @@ cmMakefileProfilingData::cmMakefileProfilingData(
     throw std::runtime_error(std::string("Unable to open: ") + profileStream);
   }
 
+  if (this->OutputFormat == Format::Summary) {
+    this->Counters = cm::make_unique<Json::Value>(Json::objectValue);
+    return;
+  }
+
   this->ProfileStream << "[";
 };
 
@@ -35,7 +44,11 @@ cmMakefileProfilingData::~cmMakefileProfilingData() noexcept
 {
   if (this->ProfileStream.good()) {
     try {
-      this->ProfileStream << "]";
+      if (this->OutputFormat == Format::Summary) {
+        this->WriteSummary();
+      } else {
+        this->ProfileStream << "]";
+      }
       this->ProfileStream.close();
     } catch (...) {
       cmSystemTools::Error("Error writing profiling output!");
@@ -43,9 +56,51 @@ cmMakefileProfilingData::~cmMakefileProfilingData() noexcept
   }
 }
 
+namespace {
+// Reading the resident memory of the process costs a file read on some
+// platforms, so a sample is reused for commands that start or end
+// within this interval of it.
+auto const MemorySampleInterval = std::chrono::milliseconds(10);
+}
+
+long long cmMakefileProfilingData::SampleMemory(
+  std::chrono::steady_clock::time_point now)
+{
+  if (!this->MemorySampled ||
+      now - this->MemorySampleTime >= MemorySampleInterval) {
+    cmsys::SystemInformation info;
+    this->MemorySample = info.GetProcMemoryUsed();
+    this->MemorySampleTime = now;
+    this->MemorySampled = true;
+  }
+  return this->MemorySample;
+}
+
+void cmMakefileProfilingData::WriteMemoryCounter()
+{
+  if (this->MemorySample == this->MemoryReported) {
+    return;
+  }
+  this->MemoryReported = this->MemorySample;
+  Json::Value values;
+  values["rss"] = Json::Value::Int64(this->MemorySample);
+  this->CounterEntry("memory", values);
+}
+
 void cmMakefileProfilingData::StartEntry(const cmListFileFunction& lff,
                                          cmListFileContext const& lfc)
 {
+  if (this->OutputFormat == Format::Summary) {
+    SummaryEntry entry;
+    entry.Name = lff.LowerCaseName();
+    entry.Location = cmStrCat(lfc.FilePath, ':', lfc.Line);
+    entry.Directory = cmSystemTools::GetFilenamePath(lfc.FilePath);
+    entry.Start = std::chrono::steady_clock::now();
+    entry.Memory = this->SampleMemory(entry.Start);
+    this->SummaryStack.push_back(std::move(entry));
+    return;
+  }
+
   /* Do not try again if we previously failed to write to output. */
   if (!this->ProfileStream.good()) {
     return;
@@ -56,13 +111,14 @@ void cmMakefileProfilingData::StartEntry(const cmListFileFunction& lff,
       this->ProfileStream << ",";
     }
     cmsys::SystemInformation info;
+    auto const now = std::chrono::steady_clock::now();
     Json::Value v;
     v["ph"] = "B";
     v["name"] = lff.LowerCaseName();
     v["cat"] = "cmake";
     v["ts"] = Json::Value::UInt64(
       std::chrono::duration_cast<std::chrono::microseconds>(
-        std::chrono::steady_clock::now().time_since_epoch())
+        now.time_since_epoch())
         .count());
     v["pid"] = static_cast<int>(info.GetProcessId());
     v["tid"] = 0;
@@ -78,6 +134,8 @@ void cmMakefileProfilingData::StartEntry(const cmListFileFunction& lff,
     v["args"] = argsValue;
 
     this->JsonWriter->write(v, &this->ProfileStream);
+    this->MemoryStack.push_back(this->SampleMemory(now));
+    this->WriteMemoryCounter();
   } catch (std::ios_base::failure& fail) {
     cmSystemTools::Error(
       cmStrCat("Failed to write to profiling output: ", fail.what()));
@@ -88,6 +146,11 @@ void cmMakefileProfilingData::StartEntry(const cmListFileFunction& lff,
 
 void cmMakefileProfilingData::StopEntry()
 {
+  if (this->OutputFormat == Format::Summary) {
+    this->StopSummaryEntry();
+    return;
+  }
+
   /* Do not try again if we previously failed to write to output. */
   if (!this->ProfileStream.good()) {
     return;
@@ -96,15 +159,28 @@ void cmMakefileProfilingData::StopEntry()
   try {
     this->ProfileStream << ",";
     cmsys::SystemInformation info;
+    auto const now = std::chrono::steady_clock::now();
     Json::Value v;
     v["ph"] = "E";
     v["ts"] = Json::Value::UInt64(
       std::chrono::duration_cast<std::chrono::microseconds>(
-        std::chrono::steady_clock::now().time_since_epoch())
+        now.time_since_epoch())
         .count());
     v["pid"] = static_cast<int>(info.GetProcessId());
     v["tid"] = 0;
+
+    // Attribute the change in resident memory to this entry, which
+    // includes any nested entries such as a subdirectory's commands.
+    long long const memory = this->SampleMemory(now);
+    if (!this->MemoryStack.empty()) {
+      long long const delta = memory - this->MemoryStack.back();
+      if (delta != 0) {
+        v["args"]["rssDelta"] = Json::Value::Int64(delta);
+      }
+      this->MemoryStack.pop_back();
+    }
     this->JsonWriter->write(v, &this->ProfileStream);
+    this->WriteMemoryCounter();
   } catch (std::ios_base::failure& fail) {
     cmSystemTools::Error(
       cmStrCat("Failed to write to profiling output:", fail.what()));
@@ -112,3 +188,137 @@ void cmMakefileProfilingData::StopEntry()
     cmSystemTools::Error("Error writing profiling output!");
   }
 }
+
+void cmMakefileProfilingData::CounterEntry(std::string const& name,
+                                           Json::Value const& values)
+{
+  if (this->OutputFormat == Format::Summary) {
+    // Only the final value of each counter is reported.
+    (*this->Counters)[name] = values;
+    return;
+  }
+
+  /* Do not try again if we previously failed to write to output. */
+  if (!this->ProfileStream.good()) {
+    return;
+  }
+
+  try {
+    if (this->ProfileStream.tellp() > 1) {
+      this->ProfileStream << ",";
+    }
+    cmsys::SystemInformation info;
+    Json::Value v;
+    v["ph"] = "C";
+    v["name"] = name;
+    v["cat"] = "cmake";
+    v["ts"] = Json::Value::UInt64(
+      std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch())
+        .count());
+    v["pid"] = static_cast<int>(info.GetProcessId());
+    v["tid"] = 0;
+    v["args"] = values;
+    this->JsonWriter->write(v, &this->ProfileStream);
+  } catch (std::ios_base::failure& fail) {
+    cmSystemTools::Error(
+      cmStrCat("Failed to write to profiling output: ", fail.what()));
+  } catch (...) {
+    cmSystemTools::Error("Error writing profiling output!");
+  }
+}
+
+void cmMakefileProfilingData::StopSummaryEntry()
+{
+  if (this->SummaryStack.empty()) {
+    return;
+  }
+  SummaryEntry const& entry = this->SummaryStack.back();
+  auto const now = std::chrono::steady_clock::now();
+  auto const inclusive = now - entry.Start;
+  auto const exclusive = inclusive - entry.Children;
+  long long const inclusiveMemory = this->SampleMemory(now) - entry.Memory;
+  long long const exclusiveMemory = inclusiveMemory - entry.ChildrenMemory;
+
+  auto addCall = [&](SummaryStats& stats) {
+    ++stats.Calls;
+    stats.Inclusive += inclusive;
+    stats.Exclusive += exclusive;
+    if (stats.Calls == 1 || inclusive > stats.Slowest) {
+      stats.Slowest = inclusive;
+      stats.SlowestLocation = entry.Location;
+    }
+    stats.InclusiveMemory += inclusiveMemory;
+    stats.ExclusiveMemory += exclusiveMemory;
+  };
+  addCall(this->CommandStats[entry.Name]);
+  SummaryStats& locationStats = this->LocationStats[entry.Location];
+  locationStats.Name = entry.Name;
+  addCall(locationStats);
+  addCall(this->DirectoryStats[entry.Directory]);
+
+  this->SummaryStack.pop_back();
+  if (!this->SummaryStack.empty()) {
+    this->SummaryStack.back().Children += inclusive;
+    this->SummaryStack.back().ChildrenMemory += inclusiveMemory;
+  }
+}
+
+namespace {
+Json::Value::Int64 ToMicroseconds(std::chrono::steady_clock::duration d)
+{
+  return static_cast<Json::Value::Int64>(
+    std::chrono::duration_cast<std::chrono::microseconds>(d).count());
+}
+}
+
+void cmMakefileProfilingData::WriteSummary()
+{
+  // Members of JSON objects are written sorted by name, so the output of
+  // two runs can be compared line by line.
+  Json::Value summary = Json::objectValue;
+
+  Json::Value& commands = summary["commands"] = Json::objectValue;
+  for (auto const& cs : this->CommandStats) {
+    Json::Value& command = commands[cs.first];
+    command["calls"] = Json::Value::UInt64(cs.second.Calls);
+    command["inclusive"] = ToMicroseconds(cs.second.Inclusive);
+    command["exclusive"] = ToMicroseconds(cs.second.Exclusive);
+    command["slowest"] = ToMicroseconds(cs.second.Slowest);
+    command["slowestLocation"] = cs.second.SlowestLocation;
+    command["inclusiveMemory"] = Json::Value::Int64(cs.second.InclusiveMemory);
+    command["exclusiveMemory"] = Json::Value::Int64(cs.second.ExclusiveMemory);
+  }
+
+  Json::Value& locations = summary["locations"] = Json::objectValue;
+  for (auto const& ls : this->LocationStats) {
+    Json::Value& location = locations[ls.first];
+    location["command"] = ls.second.Name;
+    location["calls"] = Json::Value::UInt64(ls.second.Calls);
+    location["inclusive"] = ToMicroseconds(ls.second.Inclusive);
+    location["exclusive"] = ToMicroseconds(ls.second.Exclusive);
+    location["slowest"] = ToMicroseconds(ls.second.Slowest);
+    location["inclusiveMemory"] =
+      Json::Value::Int64(ls.second.InclusiveMemory);
+    location["exclusiveMemory"] =
+      Json::Value::Int64(ls.second.ExclusiveMemory);
+  }
+
+  // Nested calls of a directory are made from other directories, so
+  // only exclusive values add up across directories.
+  Json::Value& directories = summary["directories"] = Json::objectValue;
+  for (auto const& ds : this->DirectoryStats) {
+    Json::Value& directory = directories[ds.first];
+    directory["calls"] = Json::Value::UInt64(ds.second.Calls);
+    directory["exclusive"] = ToMicroseconds(ds.second.Exclusive);
+    directory["exclusiveMemory"] =
+      Json::Value::Int64(ds.second.ExclusiveMemory);
+  }
+
+  summary["counters"] = *this->Counters;
+  summary["memoryUnit"] = "KiB";
+  summary["unit"] = "us";
+
+  this->JsonWriter->write(summary, &this->ProfileStream);
+  this->ProfileStream << "\n";
+}
@@ -1,13 +1,17 @@
 /* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
    file Copyright.txt or https://cmake.org/licensing for details.  */
 #pragma once
+#include <chrono>
+#include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "cmsys/FStream.hxx"
 
 namespace Json {
 class StreamWriter;
+class Value;
 }
 
 class cmListFileContext;
@@ -16,12 +20,64 @@ class cmListFileFunction;
 class cmMakefileProfilingData
 {
 public:
-  cmMakefileProfilingData(const std::string&);
+  enum class Format
+  {
+    // Stream events in the Google Trace Event Format.
+    GoogleTrace,
+    // Aggregate time and resident memory per command name, per call
+    // site and per directory, and write one table when profiling ends.
+    Summary
+  };
+
+  cmMakefileProfilingData(const std::string&,
+                          Format format = Format::GoogleTrace);
   ~cmMakefileProfilingData() noexcept;
   void StartEntry(const cmListFileFunction& lff, cmListFileContext const& lfc);
   void StopEntry();
+  void CounterEntry(std::string const& name, Json::Value const& values);
 
 private:
+  struct SummaryEntry
+  {
+    std::string Name;
+    std::string Location;
+    std::string Directory;
+    std::chrono::steady_clock::time_point Start;
+    std::chrono::steady_clock::duration Children{};
+    long long Memory = 0;
+    long long ChildrenMemory = 0;
+  };
+  struct SummaryStats
+  {
+    std::string Name;
+    unsigned long long Calls = 0;
+    std::chrono::steady_clock::duration Inclusive{};
+    std::chrono::steady_clock::duration Exclusive{};
+    std::chrono::steady_clock::duration Slowest{};
+    std::string SlowestLocation;
+    long long InclusiveMemory = 0;
+    long long ExclusiveMemory = 0;
+  };
+
+  long long SampleMemory(std::chrono::steady_clock::time_point now);
+  void WriteMemoryCounter();
+  void StopSummaryEntry();
+  void WriteSummary();
+
+  Format OutputFormat;
   cmsys::ofstream ProfileStream;
   std::unique_ptr<Json::StreamWriter> JsonWriter;
+  // Resident memory of the process in KiB when each open entry started.
+  // Reading it is costly, so it is sampled at a limited rate.
+  std::vector<long long> MemoryStack;
+  long long MemorySample = 0;
+  std::chrono::steady_clock::time_point MemorySampleTime;
+  bool MemorySampled = false;
+  long long MemoryReported = -1;
+  // Open entries and statistics of finished entries for the summary.
+  std::vector<SummaryEntry> SummaryStack;
+  std::map<std::string, SummaryStats> CommandStats;
+  std::map<std::string, SummaryStats> LocationStats;
+  std::map<std::string, SummaryStats> DirectoryStats;
+  std::unique_ptr<Json::Value> Counters;
 };
@@ -17,6 +17,7 @@
 #include "cmComputeLinkInformation.h"
 #include "cmCustomCommand.h"
 #include "cmCustomCommandGenerator.h"
+#include "cmDependsC.h"
 #include "cmGeneratedFileStream.h"
 #include "cmGeneratorExpression.h"
 #include "cmGeneratorTarget.h"
@@ -327,6 +328,22 @@ void cmMakefileTargetGenerator::WriteCommonCodeRules()
            this->LocalGenerator->GetBinaryDirectory(), dependFileNameFull))
     << "\n\n";
 
+  // Include the dependencies written by the compiler, if any.
+  std::string compilerDependFileNameFull;
+  if (this->Makefile->IsOn("CMAKE_DEPENDS_USE_COMPILER")) {
+    compilerDependFileNameFull =
+      cmStrCat(this->TargetBuildDirectoryFull, "/compiler_depend.make");
+    *this->BuildFileStream
+      << "# Include any dependencies generated by the compiler for this "
+         "target.\n"
+      << this->GlobalGenerator->IncludeDirective << " " << root
+      << cmSystemTools::ConvertToOutputPath(
+           this->LocalGenerator->MaybeConvertToRelativePath(
+             this->LocalGenerator->GetBinaryDirectory(),
+             compilerDependFileNameFull))
+      << "\n\n";
+  }
+
   if (!this->NoRuleMessages) {
     // Include the progress variables for the target.
     *this->BuildFileStream
@@ -348,6 +365,15 @@ void cmMakefileTargetGenerator::WriteCommonCodeRules()
                   << this->GeneratorTarget->GetName() << ".\n"
                   << "# This may be replaced when dependencies are built.\n";
   }
+  if (!compilerDependFileNameFull.empty() &&
+      !cmSystemTools::FileExists(compilerDependFileNameFull)) {
+    cmGeneratedFileStream depFileStream(
+      compilerDependFileNameFull, false,
+      this->GlobalGenerator->GetMakefileEncoding());
+    depFileStream << "# Empty compiler generated dependencies file for "
+                  << this->GeneratorTarget->GetName() << ".\n"
+                  << "# This may be replaced when dependencies are built.\n";
+  }
 
   // Open the flags file.  This should be copy-if-different because the
   // rules may depend on this file itself.
@@ -510,8 +536,11 @@ void cmMakefileTargetGenerator::WriteObjectRuleFiles(
   objFullPath = cmSystemTools::CollapseFullPath(objFullPath);
   std::string srcFullPath =
     cmSystemTools::CollapseFullPath(source.GetFullPath());
-  this->LocalGenerator->AddImplicitDepends(this->GeneratorTarget, lang,
-                                           objFullPath, srcFullPath);
+  bool const compilerDepends = this->CheckUseCompilerDepends(lang);
+  if (!compilerDepends) {
+    this->LocalGenerator->AddImplicitDepends(this->GeneratorTarget, lang,
+                                             objFullPath, srcFullPath);
+  }
 
   this->LocalGenerator->AppendRuleDepend(depends,
                                          this->FlagFileNameFull.c_str());
@@ -553,8 +582,10 @@ void cmMakefileTargetGenerator::WriteObjectRuleFiles(
         depends.push_back(
           this->GeneratorTarget->GetPchFile(config, lang, arch));
       }
-      this->LocalGenerator->AddImplicitDepends(this->GeneratorTarget, lang,
-                                               objFullPath, pchHeader);
+      if (!compilerDepends) {
+        this->LocalGenerator->AddImplicitDepends(this->GeneratorTarget, lang,
+                                                 objFullPath, pchHeader);
+      }
     }
   }
 
@@ -774,6 +805,25 @@ void cmMakefileTargetGenerator::WriteObjectRuleFiles(
       this->LocalGenerator->GetCurrentBinaryDirectory(), objectFileDir),
     cmOutputConverter::SHELL);
   vars.ObjectFileDir = objectFileDir.c_str();
+  // Let the compiler write the dependencies of the object as a side
+  // effect of compiling it.  They are merged into compiler_depend.make
+  // by the depend step of the next build.
+  std::string compileFlags = flags;
+  if (compilerDepends) {
+    std::string const depFile = cmStrCat(obj, ".d");
+    std::string depfileFlags = this->Makefile->GetSafeDefinition(
+      cmStrCat("CMAKE_DEPFILE_FLAGS_", lang));
+    cmSystemTools::ReplaceString(
+      depfileFlags, "<DEPFILE>",
+      this->LocalGenerator->ConvertToOutputFormat(depFile,
+                                                  cmOutputConverter::SHELL));
+    cmSystemTools::ReplaceString(depfileFlags, "<OBJECT>", shellObj);
+    this->LocalGenerator->AppendFlags(compileFlags, depfileFlags);
+    this->CompilerDependencyFiles.emplace(objFullPath,
+                                          cmStrCat(objFullPath, ".d"));
+    this->CleanFiles.insert(depFile);
+  }
+
   vars.Flags = flags.c_str();
   vars.ISPCHeader = ispcHeaderForShell.c_str();
 
@@ -951,11 +1001,13 @@ void cmMakefileTargetGenerator::WriteObjectRuleFiles(
     }
 
     // Expand placeholders in the commands.
+    vars.Flags = compileFlags.c_str();
     for (std::string& compileCommand : compileCommands) {
       compileCommand = cmStrCat(launcher, compileCommand);
       rulePlaceholderExpander->ExpandRuleVariables(this->LocalGenerator,
                                                    compileCommand, vars);
     }
+    vars.Flags = flags.c_str();
 
     // Change the command working directory to the local build tree.
     this->LocalGenerator->CreateCDCommand(
@@ -1211,6 +1263,30 @@ void cmMakefileTargetGenerator::WriteTargetDependRules()
     *this->InfoFileStream << "  )\n\n";
   }
 
+  // Tell the scanner to list the files it found for the stamp.
+  if (this->CheckUseDependStamp()) {
+    *this->InfoFileStream
+      << "\n"
+      << "# Scan dependencies only when an input of the stamp changes.\n"
+      << "set(CMAKE_DEPENDS_SKIP_UNCHANGED 1)\n";
+  }
+
+  // Store the dependency files written by the compiler for each object.
+  if (!this->CompilerDependencyFiles.empty()) {
+    /* clang-format off */
+    *this->InfoFileStream
+      << "\n"
+      << "# Dependency files written by the compiler for each object.\n"
+      << "set(CMAKE_DEPENDS_DEPENDENCY_FILES\n";
+    /* clang-format on */
+    for (auto const& df : this->CompilerDependencyFiles) {
+      *this->InfoFileStream
+        << "  " << cmOutputConverter::EscapeForCMake(df.first) << " "
+        << cmOutputConverter::EscapeForCMake(df.second) << "\n";
+    }
+    *this->InfoFileStream << "  )\n";
+  }
+
   // Store list of targets linked directly or transitively.
   {
     /* clang-format off */
@@ -1305,8 +1381,64 @@ void cmMakefileTargetGenerator::WriteTargetDependRules()
   }
 
   // Write the rule.
+  if (!this->CheckUseDependStamp()) {
+    this->LocalGenerator->WriteMakeRule(*this->BuildFileStream, nullptr,
+                                        depTarget, depends, commands, true);
+    return;
+  }
+
+  // Run the dependency scanner only when one of its inputs is newer than
+  // the stamp it touches.  The scanner adds the files it found to the
+  // dependencies of the stamp in depend.make.  This avoids starting a
+  // CMake process for every target in a build with nothing to do.
+  std::string const depStamp = cmStrCat(
+    this->LocalGenerator->GetRelativeTargetDirectory(this->GeneratorTarget),
+    "/depend.ts");
+  depends.push_back(this->InfoFileNameFull);
+  depends.push_back(
+    cmStrCat(this->LocalGenerator->GetCurrentBinaryDirectory(),
+             "/CMakeFiles/CMakeDirectoryInformation.cmake"));
+  std::vector<std::string> no_commands;
+  std::vector<std::string> no_depends;
+  for (auto const& df : this->CompilerDependencyFiles) {
+    // A missing dependency file has not been written by the compiler yet.
+    depends.push_back(df.second);
+    this->LocalGenerator->WriteMakeRule(*this->BuildFileStream, nullptr,
+                                        df.second, no_depends, no_commands,
+                                        false);
+  }
+  this->LocalGenerator->WriteMakeRule(*this->BuildFileStream, nullptr,
+                                      depStamp, depends, commands, false);
   this->LocalGenerator->WriteMakeRule(*this->BuildFileStream, nullptr,
-                                      depTarget, depends, commands, true);
+                                      depTarget, { depStamp }, no_commands,
+                                      true);
+}
+
+bool cmMakefileTargetGenerator::CheckUseDependStamp() const
+{
+  if (!this->Makefile->IsOn("CMAKE_DEPENDS_SKIP_UNCHANGED")) {
+    return false;
+  }
+
+  // The rule file of a utility target does not include depend.make,
+  // which lists the dependencies of the stamp.
+  if (this->GeneratorTarget->GetType() == cmStateEnums::UTILITY) {
+    return false;
+  }
+
+  // The scanner must run every time to check multiple output pairs.
+  if (!this->MultipleOutputPairs.empty()) {
+    return false;
+  }
+
+  // Only the C-like scanner records the files it found for the stamp.
+  for (auto const& implicitLang :
+       this->LocalGenerator->GetImplicitDepends(this->GeneratorTarget)) {
+    if (!cmDependsC::IsScannedLanguage(implicitLang.first)) {
+      return false;
+    }
+  }
+  return true;
 }
 
 void cmMakefileTargetGenerator::DriveCustomCommands(
@@ -1824,6 +1956,17 @@ void cmMakefileTargetGenerator::CreateLinkScript(
   makefile_depends.push_back(std::move(linkScriptName));
 }
 
+bool cmMakefileTargetGenerator::CheckUseCompilerDepends(
+  std::string const& l) const
+{
+  // The compiler must know how to write a gcc-style depfile.
+  return this->Makefile->IsOn("CMAKE_DEPENDS_USE_COMPILER") &&
+    this->Makefile->GetSafeDefinition(cmStrCat("CMAKE_", l,
+                                               "_DEPFILE_FORMAT")) == "gcc" &&
+    !this->Makefile->GetSafeDefinition(cmStrCat("CMAKE_DEPFILE_FLAGS_", l))
+       .empty();
+}
+
 bool cmMakefileTargetGenerator::CheckUseResponseFileForObjects(
   std::string const& l) const
 {
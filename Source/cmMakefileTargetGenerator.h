@@ -160,6 +160,8 @@ protected:
   std::string CreateResponseFile(const char* name, std::string const& options,
                                  std::vector<std::string>& makefile_depends);
 
+  bool CheckUseCompilerDepends(std::string const& l) const;
+  bool CheckUseDependStamp() const;
   bool CheckUseResponseFileForObjects(std::string const& l) const;
   bool CheckUseResponseFileForLibraries(std::string const& l) const;
 
@@ -240,6 +242,9 @@ protected:
 
   using MultipleOutputPairsType = std::map<std::string, std::string>;
   MultipleOutputPairsType MultipleOutputPairs;
+
+  // Map from object file to the dependency file written by the compiler.
+  std::map<std::string, std::string> CompilerDependencyFiles;
   bool WriteMakeRule(std::ostream& os, const char* comment,
                      const std::vector<std::string>& outputs,
                      const std::vector<std::string>& depends,
@@ -63,7 +63,7 @@ public:
 
   void FindConflicts(unsigned int index)
   {
-    for (unsigned int i = 0; i < this->OD->OriginalDirectories.size(); ++i) {
+    for (int i : this->GetCandidateDirectories()) {
       // Check if this directory conflicts with the entry.
       std::string const& dir = this->OD->OriginalDirectories[i];
       if (!this->OD->IsSameDirectory(dir, this->Directory) &&
@@ -80,8 +80,9 @@ public:
   void FindImplicitConflicts(std::ostringstream& w)
   {
     bool first = true;
-    for (std::string const& dir : this->OD->OriginalDirectories) {
+    for (int i : this->GetCandidateDirectories()) {
       // Check if this directory conflicts with the entry.
+      std::string const& dir = this->OD->OriginalDirectories[i];
       if (dir != this->Directory &&
           cmSystemTools::GetRealPath(dir) !=
             cmSystemTools::GetRealPath(this->Directory) &&
@@ -102,6 +103,19 @@ public:
 protected:
   virtual bool FindConflict(std::string const& dir) = 0;
 
+  // Add the indices of directories listing names that may conflict.
+  // FindConflict makes the final decision for each of them.
+  virtual void FindCandidates(std::vector<int>& dirs) = 0;
+
+  std::vector<int> GetCandidateDirectories()
+  {
+    std::vector<int> dirs;
+    this->FindCandidates(dirs);
+    std::sort(dirs.begin(), dirs.end());
+    dirs.erase(std::unique(dirs.begin(), dirs.end()), dirs.end());
+    return dirs;
+  }
+
   bool FileMayConflict(std::string const& dir, std::string const& name);
 
   cmOrderDirectories* OD;
@@ -164,6 +178,7 @@ public:
   }
 
   bool FindConflict(std::string const& dir) override;
+  void FindCandidates(std::vector<int>& dirs) override;
 
 private:
   // The soname of the shared library if it is known.
@@ -198,6 +213,15 @@ bool cmOrderDirectoriesConstraintSOName::FindConflict(std::string const& dir)
   return false;
 }
 
+void cmOrderDirectoriesConstraintSOName::FindCandidates(std::vector<int>& dirs)
+{
+  if (!this->SOName.empty()) {
+    this->OD->FindDirectoriesWithFile(this->SOName, dirs);
+  } else {
+    this->OD->FindDirectoriesWithPrefix(this->FileName, dirs);
+  }
+}
+
 class cmOrderDirectoriesConstraintLibrary : public cmOrderDirectoriesConstraint
 {
 public:
@@ -213,6 +237,7 @@ public:
   }
 
   bool FindConflict(std::string const& dir) override;
+  void FindCandidates(std::vector<int>& dirs) override;
 };
 
 bool cmOrderDirectoriesConstraintLibrary::FindConflict(std::string const& dir)
@@ -240,6 +265,21 @@ bool cmOrderDirectoriesConstraintLibrary::FindConflict(std::string const& dir)
   return false;
 }
 
+void cmOrderDirectoriesConstraintLibrary::FindCandidates(std::vector<int>& dirs)
+{
+  this->OD->FindDirectoriesWithFile(this->FileName, dirs);
+  if (!this->OD->LinkExtensions.empty() &&
+      this->OD->RemoveLibraryExtension.find(this->FileName)) {
+    std::string lib = this->OD->RemoveLibraryExtension.match(1);
+    std::string ext = this->OD->RemoveLibraryExtension.match(2);
+    for (std::string const& LinkExtension : this->OD->LinkExtensions) {
+      if (LinkExtension != ext) {
+        this->OD->FindDirectoriesWithFile(cmStrCat(lib, LinkExtension), dirs);
+      }
+    }
+  }
+}
+
 cmOrderDirectories::cmOrderDirectories(cmGlobalGenerator* gg,
                                        const cmGeneratorTarget* target,
                                        const char* purpose)
@@ -430,6 +470,10 @@ void cmOrderDirectories::FindConflicts()
   this->ConflictGraph.resize(this->OriginalDirectories.size());
   this->DirectoryVisited.resize(this->OriginalDirectories.size(), 0);
 
+  // Look up each constraint only in directories listing its files
+  // instead of checking the file system for every pair.
+  this->LoadDirectoryNames();
+
   // Find directories conflicting with each entry.
   for (unsigned int i = 0; i < this->ConstraintEntries.size(); ++i) {
     this->ConstraintEntries[i]->FindConflicts(i);
@@ -450,6 +494,43 @@ void cmOrderDirectories::FindConflicts()
   this->FindImplicitConflicts();
 }
 
+void cmOrderDirectories::LoadDirectoryNames()
+{
+  this->DirectoryNames.clear();
+  this->DirectoryNames.reserve(this->OriginalDirectories.size());
+  for (std::string const& dir : this->OriginalDirectories) {
+    this->DirectoryNames.push_back(
+      &this->GlobalGenerator->GetFoldedDirectoryContent(dir));
+  }
+}
+
+void cmOrderDirectories::FindDirectoriesWithFile(std::string const& name,
+                                                 std::vector<int>& dirs) const
+{
+  std::string const key = cmGlobalGenerator::FoldDirectoryContentName(name);
+  for (unsigned int i = 0; i < this->DirectoryNames.size(); ++i) {
+    if (this->DirectoryNames[i]->count(key)) {
+      dirs.push_back(static_cast<int>(i));
+    }
+  }
+}
+
+void cmOrderDirectories::FindDirectoriesWithPrefix(std::string const& prefix,
+                                                   std::vector<int>& dirs) const
+{
+  if (prefix.empty()) {
+    return;
+  }
+  std::string const key = cmGlobalGenerator::FoldDirectoryContentName(prefix);
+  for (unsigned int i = 0; i < this->DirectoryNames.size(); ++i) {
+    std::set<std::string> const& names = *this->DirectoryNames[i];
+    auto it = names.lower_bound(key);
+    if (it != names.end() && cmHasPrefix(*it, key)) {
+      dirs.push_back(static_cast<int>(i));
+    }
+  }
+}
+
 void cmOrderDirectories::FindImplicitConflicts()
 {
   // Check for items in implicit link directories that have conflicts
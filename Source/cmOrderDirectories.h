@@ -64,6 +64,14 @@ private:
   void AddOriginalDirectories(std::vector<std::string> const& dirs);
   void FindConflicts();
   void FindImplicitConflicts();
+
+  // Names in each original directory, shared with the global generator.
+  std::vector<std::set<std::string> const*> DirectoryNames;
+  void LoadDirectoryNames();
+  void FindDirectoriesWithFile(std::string const& name,
+                               std::vector<int>& dirs) const;
+  void FindDirectoriesWithPrefix(std::string const& prefix,
+                                 std::vector<int>& dirs) const;
   void OrderDirectories();
   void VisitDirectory(unsigned int i);
   void DiagnoseCycle();
@@ -93,4 +101,5 @@ private:
 
   friend class cmOrderDirectoriesConstraint;
   friend class cmOrderDirectoriesConstraintLibrary;
+  friend class cmOrderDirectoriesConstraintSOName;
 };
@@ -759,6 +759,16 @@ unsigned int cmState::GetCacheMinorVersion() const
   return this->CacheManager->GetCacheMinorVersion();
 }
 
+unsigned long cmState::GetCacheSidecarHits() const
+{
+  return this->CacheManager->GetSidecarHits();
+}
+
+unsigned long cmState::GetCacheSidecarMisses() const
+{
+  return this->CacheManager->GetSidecarMisses();
+}
+
 cmState::Mode cmState::GetMode() const
 {
   return this->CurrentMode;
@@ -13,6 +13,7 @@
 #include <vector>
 
 #include "cmDefinitions.h"
+#include "cmFileSystemCache.h"
 #include "cmLinkedTree.h"
 #include "cmListFileCache.h"
 #include "cmPolicies.h"
@@ -200,6 +201,8 @@ public:
 
   unsigned int GetCacheMajorVersion() const;
   unsigned int GetCacheMinorVersion() const;
+  unsigned long GetCacheSidecarHits() const;
+  unsigned long GetCacheSidecarMisses() const;
 
   Mode GetMode() const;
   std::string GetModeString() const;
@@ -207,6 +210,9 @@ public:
 
   static std::string ModeToString(Mode mode);
 
+  cmListFileCache& GetListFileCache() { return this->ListFileCache; }
+  cmFileSystemCache& GetFileSystemCache() { return this->FileSystemCache; }
+
 private:
   friend class cmake;
   void AddCacheEntry(const std::string& key, const char* value,
@@ -232,6 +238,8 @@ private:
   cmPropertyMap GlobalProperties;
   std::unique_ptr<cmCacheManager> CacheManager;
   std::unique_ptr<cmGlobVerificationManager> GlobVerificationManager;
+  cmListFileCache ListFileCache;
+  cmFileSystemCache FileSystemCache;
 
   cmLinkedTree<cmStateDetail::BuildsystemDirectoryStateType>
     BuildsystemDirectory;
@@ -2,8 +2,10 @@
    file Copyright.txt or https://cmake.org/licensing for details.  */
 #include "cmTryCompileCommand.h"
 
+#include "cmFileSystemCache.h"
 #include "cmMakefile.h"
 #include "cmMessageType.h"
+#include "cmState.h"
 #include "cmake.h"
 
 class cmExecutionStatus;
@@ -32,5 +34,9 @@ bool cmTryCompileCommand::InitialPass(std::vector<std::string> const& argv,
       this->CleanupFiles(this->BinaryDirectory);
     }
   }
+
+  // The build may have changed anything below the binary directory.
+  this->Makefile->GetState()->GetFileSystemCache().Invalidate(
+    this->BinaryDirectory);
   return true;
 }
@@ -7,6 +7,7 @@
 #include "cmsys/FStream.hxx"
 
 #include "cmDuration.h"
+#include "cmFileSystemCache.h"
 #include "cmMakefile.h"
 #include "cmMessageType.h"
 #include "cmProperty.h"
@@ -160,6 +161,10 @@ bool cmTryRunCommand::InitialPass(std::vector<std::string> const& argv,
   if (!this->Makefile->GetCMakeInstance()->GetDebugTryCompile()) {
     this->CleanupFiles(this->BinaryDirectory);
   }
+
+  // The build may have changed anything below the binary directory.
+  this->Makefile->GetState()->GetFileSystemCache().Invalidate(
+    this->BinaryDirectory);
   return true;
 }
 
@@ -190,6 +195,8 @@ void cmTryRunCommand::RunExecutable(const std::string& runArgs,
   bool worked = cmSystemTools::RunSingleCommand(
     finalCommand, out, out, &retVal, nullptr, cmSystemTools::OUTPUT_NONE,
     cmDuration::zero());
+  // The executable may have changed anything.
+  this->Makefile->GetState()->GetFileSystemCache().Clear();
   // set the run var
   char retChar[16];
   const char* retStr;
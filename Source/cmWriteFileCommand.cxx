@@ -7,7 +7,9 @@
 #include "cm_sys_stat.h"
 
 #include "cmExecutionStatus.h"
+#include "cmFileSystemCache.h"
 #include "cmMakefile.h"
+#include "cmState.h"
 #include "cmStringAlgorithms.h"
 #include "cmSystemTools.h"
 
@@ -42,6 +44,8 @@ bool cmWriteFileCommand(std::vector<std::string> const& args,
     return false;
   }
 
+  status.GetMakefile().GetState()->GetFileSystemCache().Invalidate(fileName);
+
   std::string dir = cmSystemTools::GetFilenamePath(fileName);
   cmSystemTools::MakeDirectory(dir);
 
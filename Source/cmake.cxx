@@ -524,6 +524,18 @@ bool cmake::SetCacheArgs(const std::vector<std::string>& args)
         cmSystemTools::GetCurrentWorkingDirectory());
       this->ReadListFile(args, path);
       seenScriptOption = true;
+    } else if (cmHasLiteralPrefix(arg, "--try-compile-cache=")) {
+      std::string path = arg.substr(strlen("--try-compile-cache="));
+      if (path.empty()) {
+        cmSystemTools::Error("No directory specified for --try-compile-cache");
+        return false;
+      }
+      path = cmSystemTools::CollapseFullPath(path);
+      cmSystemTools::ConvertToUnixSlashes(path);
+      this->AddCacheEntry("CMAKE_TRY_COMPILE_CACHE_DIR", path.c_str(),
+                          "Directory holding results of try_compile checks "
+                          "shared between build trees.",
+                          cmStateEnums::PATH);
     } else if (arg == "--" && seenScriptOption) {
       // Stop processing CMake args and avoid possible errors
       // when arbitrary args are given to CMake script.
@@ -812,6 +824,8 @@ void cmake::SetArgs(const std::vector<std::string>& args)
       i++;
     } else if (cmHasLiteralPrefix(arg, "-W")) {
       // skip for now
+    } else if (cmHasLiteralPrefix(arg, "--try-compile-cache=")) {
+      // skip for now
     } else if (cmHasLiteralPrefix(arg, "--graphviz=")) {
       std::string path = arg.substr(strlen("--graphviz="));
       path = cmSystemTools::CollapseFullPath(path);
@@ -985,19 +999,22 @@ void cmake::SetArgs(const std::vector<std::string>& args)
         "--profiling-format specified but no --profiling-output!");
       return;
     }
+    cmMakefileProfilingData::Format format;
     if (profilingFormat == "google-trace"_s) {
-      try {
-        this->ProfilingOutput =
-          cm::make_unique<cmMakefileProfilingData>(profilingOutput);
-      } catch (std::runtime_error& e) {
-        cmSystemTools::Error(
-          cmStrCat("Could not start profiling: ", e.what()));
-        return;
-      }
+      format = cmMakefileProfilingData::Format::GoogleTrace;
+    } else if (profilingFormat == "summary"_s) {
+      format = cmMakefileProfilingData::Format::Summary;
     } else {
       cmSystemTools::Error("Invalid format specified for --profiling-format");
       return;
     }
+    try {
+      this->ProfilingOutput =
+        cm::make_unique<cmMakefileProfilingData>(profilingOutput, format);
+    } catch (std::runtime_error& e) {
+      cmSystemTools::Error(cmStrCat("Could not start profiling: ", e.what()));
+      return;
+    }
   }
 #endif
 
@@ -2379,6 +2396,15 @@ bool cmake::LoadCache(const std::string& path, bool internal,
   for (auto const& entry : entries) {
     this->UnwatchUnusedCli(entry);
   }
+#if !defined(CMAKE_BOOTSTRAP)
+  if (this->IsProfilingEnabled()) {
+    Json::Value counters;
+    counters["hits"] = Json::Value::UInt64(this->State->GetCacheSidecarHits());
+    counters["misses"] =
+      Json::Value::UInt64(this->State->GetCacheSidecarMisses());
+    this->GetProfilingOutput().CounterEntry("cache sidecar", counters);
+  }
+#endif
   return result;
 }
 
@@ -2388,6 +2414,7 @@ bool cmake::SaveCache(const std::string& path)
   static const auto entries = { "CMAKE_CACHE_MAJOR_VERSION",
                                 "CMAKE_CACHE_MINOR_VERSION",
                                 "CMAKE_CACHE_PATCH_VERSION",
+                                "CMAKE_CACHE_SIDECAR",
                                 "CMAKE_CACHEFILE_DIR" };
   for (auto const& entry : entries) {
     this->UnwatchUnusedCli(entry);
@@ -84,6 +84,8 @@ const char* cmDocumentationOptions[][2] = {
   { "--debug-trycompile",
     "Do not delete the try_compile build tree. Only "
     "useful on one try_compile at a time." },
+  { "--try-compile-cache=<dir>",
+    "Reuse try_compile results stored in the given directory." },
   { "--debug-output", "Put cmake in a debug mode." },
   { "--debug-find", "Put cmake find in a debug mode." },
   { "--trace", "Put cmake in trace mode." },
@@ -101,7 +103,7 @@ const char* cmDocumentationOptions[][2] = {
 #  if !defined(CMAKE_BOOTSTRAP)
   { "--profiling-format=<fmt>",
     "Output data for profiling CMake scripts. Supported formats: "
-    "google-trace" },
+    "google-trace, summary" },
   { "--profiling-output=<file>",
     "Select an output path for the profiling data enabled through "
     "--profiling-format." },
@@ -1,8 +1,12 @@
 /* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
    file Copyright.txt or https://cmake.org/licensing for details.  */
 #include <iostream>
+#include <sstream>
 #include <string>
 
+#include "cmsys/FStream.hxx"
+
+#include "cmFileTime.h"
 #include "cmGeneratedFileStream.h"
 #include "cmSystemTools.h"
 
@@ -10,6 +14,177 @@
   std::cout << "FAILED: " << (m1) << (m2) << "\n";                            \
   failed = 1
 
+namespace {
+
+std::string readFile(std::string const& name)
+{
+  cmsys::ifstream fin(name.c_str(), std::ios::in | std::ios::binary);
+  std::ostringstream content;
+  content << fin.rdbuf();
+  return content.str();
+}
+
+void writeFile(std::string const& name, std::string const& content)
+{
+  cmsys::ofstream fout(name.c_str(), std::ios::out | std::ios::binary);
+  fout << content;
+}
+
+// Generate 'name' from 'content' over an existing file holding 'previous'
+// with copy-if-different, and check whether it was replaced.
+bool testCopyIfDifferent(std::string const& previous,
+                         std::string const& content, bool expectReplaced)
+{
+  std::string const name = "generatedFileCopyIfDifferent";
+  std::string const tmpName = name + ".tmp";
+  bool passed = true;
+
+  writeFile(name, previous);
+  cmFileTime before;
+  before.Load(name);
+
+  cmGeneratedFileStream gm;
+  gm.SetTempExt("tmp");
+  gm.Open(name, false, true);
+  gm.SetCopyIfDifferent(true);
+  gm << content;
+  if (cmSystemTools::FileExists(tmpName)) {
+    std::cout << "FAILED: copy-if-different output written to "
+                 "temporary file: "
+              << tmpName << "\n";
+    passed = false;
+  }
+  bool const replaced = gm.Close();
+
+  cmFileTime after;
+  after.Load(name);
+  if (replaced != expectReplaced) {
+    std::cout << "FAILED: file with content \"" << previous << "\" was "
+              << (replaced ? "" : "not ") << "replaced by \"" << content
+              << "\"\n";
+    passed = false;
+  }
+  if (!expectReplaced && before.Compare(after) != 0) {
+    std::cout << "FAILED: modification time of unchanged file changed\n";
+    passed = false;
+  }
+  if (readFile(name) != content) {
+    std::cout << "FAILED: file does not have the generated content \""
+              << content << "\"\n";
+    passed = false;
+  }
+  if (cmSystemTools::FileExists(tmpName)) {
+    std::cout << "FAILED: temporary file is still here: " << tmpName
+              << "\n";
+    passed = false;
+  }
+
+  cmSystemTools::RemoveFile(name);
+  cmSystemTools::RemoveFile(tmpName);
+  return passed;
+}
+
+// A stream used with copy-if-different writes to the temporary file
+// again when it is opened without it.
+bool testReopen()
+{
+  std::string const name1 = "generatedFileReopen1";
+  std::string const name2 = "generatedFileReopen2";
+  std::string const tmpName2 = name2 + ".tmp";
+  bool passed = true;
+
+  cmGeneratedFileStream gm;
+  gm.SetTempExt("tmp");
+  gm.SetCopyIfDifferent(true);
+  gm.Open(name1);
+  gm << "first";
+  gm.Close();
+
+  gm.SetCopyIfDifferent(false);
+  gm.Open(name2);
+  gm << "second";
+  gm.flush();
+  if (readFile(tmpName2) != "second") {
+    std::cout << "FAILED: reopened stream does not write to temporary "
+                 "file: "
+              << tmpName2 << "\n";
+    passed = false;
+  }
+  gm.Close();
+
+  if (readFile(name1) != "first" || readFile(name2) != "second") {
+    std::cout << "FAILED: reopened stream did not generate both files\n";
+    passed = false;
+  }
+
+  cmSystemTools::RemoveFile(name1);
+  cmSystemTools::RemoveFile(name2);
+  cmSystemTools::RemoveFile(tmpName2);
+  return passed;
+}
+
+// A stream closed before it is destroyed still generates output it holds
+// in memory.
+bool testCloseBeforeDestroy()
+{
+  std::string const name = "generatedFileCloseBeforeDestroy";
+  bool passed = true;
+
+  {
+    cmGeneratedFileStream gm;
+    gm.Open(name);
+    gm.SetCopyIfDifferent(true);
+    gm << "closed";
+    gm.close();
+    if (!gm) {
+      std::cout << "FAILED: closing stream held in memory failed\n";
+      passed = false;
+    }
+  }
+
+  if (readFile(name) != "closed") {
+    std::cout << "FAILED: stream closed before destruction did not "
+                 "generate file: "
+              << name << "\n";
+    passed = false;
+  }
+
+  cmSystemTools::RemoveFile(name);
+  return passed;
+}
+
+// A stream converting the encoding cannot hold its output in memory.
+bool testEncoded()
+{
+  std::string const name = "generatedFileEncoded";
+  std::string const tmpName = name + ".tmp";
+  bool passed = true;
+
+  cmGeneratedFileStream gm(cmGeneratedFileStream::Encoding::UTF8);
+  gm.SetTempExt("tmp");
+  gm.Open(name);
+  gm.SetCopyIfDifferent(true);
+  gm << "encoded";
+  gm.flush();
+  if (readFile(tmpName) != "encoded") {
+    std::cout << "FAILED: encoded stream does not write to temporary file: "
+              << tmpName << "\n";
+    passed = false;
+  }
+  gm.Close();
+
+  if (readFile(name) != "encoded") {
+    std::cout << "FAILED: encoded stream did not generate file: " << name
+              << "\n";
+    passed = false;
+  }
+
+  cmSystemTools::RemoveFile(name);
+  cmSystemTools::RemoveFile(tmpName);
+  return passed;
+}
+}
+
 int testGeneratedFileStream(int /*unused*/, char* /*unused*/ [])
 {
   int failed = 0;
@@ -84,5 +259,27 @@ int testGeneratedFileStream(int /*unused*/, char* /*unused*/ [])
   cmSystemTools::RemoveFile(file3tmp);
   cmSystemTools::RemoveFile(file4tmp);
 
+  // Content larger than the buffer used to compare it with the file.
+  std::string const large(10000, 'x');
+  if (!testCopyIfDifferent("identical", "identical", false) ||
+      !testCopyIfDifferent(large, large, false) ||
+      !testCopyIfDifferent("prefix and more", "prefix", true) ||
+      !testCopyIfDifferent("prefix", "prefix and more", true) ||
+      !testCopyIfDifferent("different", "changed!!", true) ||
+      !testCopyIfDifferent(large, large + "y", true) ||
+      !testCopyIfDifferent(large + "y", large + "z", true) ||
+      !testCopyIfDifferent("", "", false)) {
+    failed = 1;
+  }
+  if (!testReopen()) {
+    failed = 1;
+  }
+  if (!testCloseBeforeDestroy()) {
+    failed = 1;
+  }
+  if (!testEncoded()) {
+    failed = 1;
+  }
+
   return failed;
 }
@@ -0,0 +1,12 @@
+enable_language(C)
+set(CMAKE_DEPENDS_USE_COMPILER ON)
+include_directories(${CMAKE_CURRENT_BINARY_DIR})
+add_executable(MakeCompilerDepends MakeCompilerDepends.c)
+file(GENERATE OUTPUT ${CMAKE_CURRENT_BINARY_DIR}/check-$<LOWER_CASE:$<CONFIG>>.cmake CONTENT "
+set(check_pairs
+  \"$<TARGET_FILE:MakeCompilerDepends>|${CMAKE_CURRENT_BINARY_DIR}/MakeCompilerDepends.h\"
+  )
+set(check_exes
+  \"$<TARGET_FILE:MakeCompilerDepends>\"
+  )
+")
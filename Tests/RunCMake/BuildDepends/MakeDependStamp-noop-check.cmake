@@ -0,0 +1,4 @@
+if(actual_stdout MATCHES "cmake_depends")
+  string(REPLACE "\n" "\n  " actual_stdout "  ${actual_stdout}")
+  set(RunCMake_TEST_FAILED "A build with nothing to do scanned dependencies:\n${actual_stdout}")
+endif()
@@ -0,0 +1,6 @@
+#include "MakeDependStamp.h"
+
+int main(void)
+{
+  return MakeDependStamp;
+}
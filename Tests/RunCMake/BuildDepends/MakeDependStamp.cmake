@@ -0,0 +1,28 @@
+enable_language(C)
+set(CMAKE_DEPENDS_SKIP_UNCHANGED ON)
+include_directories(${CMAKE_CURRENT_BINARY_DIR})
+add_executable(MakeDependStamp MakeDependStamp.c)
+file(GENERATE OUTPUT ${CMAKE_CURRENT_BINARY_DIR}/check-$<LOWER_CASE:$<CONFIG>>.cmake CONTENT "
+set(check_pairs
+  \"$<TARGET_FILE:MakeDependStamp>|${CMAKE_CURRENT_BINARY_DIR}/MakeDependStamp.h\"
+  )
+set(check_exes
+  \"$<TARGET_FILE:MakeDependStamp>\"
+  )
+if(check_step EQUAL 1)
+  # The scanned files must be listed as inputs of the stamp.
+  file(STRINGS \"${CMAKE_CURRENT_BINARY_DIR}/CMakeFiles/MakeDependStamp.dir/depend.make\" stamped
+    REGEX \"depend[.]ts: .*MakeDependStampRemoved[.]h\")
+  if(NOT stamped)
+    string(APPEND RunCMake_TEST_FAILED \"\\n depend.make does not list the header for the stamp\\n\")
+  endif()
+endif()
+if(check_step EQUAL 2)
+  # The edited header must have been scanned again.
+  file(STRINGS \"${CMAKE_CURRENT_BINARY_DIR}/CMakeFiles/MakeDependStamp.dir/depend.make\" removed
+    REGEX \"MakeDependStampRemoved[.]h\")
+  if(removed)
+    string(APPEND RunCMake_TEST_FAILED \"\\n depend.make still lists the removed header\\n\")
+  endif()
+endif()
+")
@@ -0,0 +1,6 @@
+file(WRITE "${RunCMake_TEST_BINARY_DIR}/MakeDependStamp.h" [[
+#include "MakeDependStampRemoved.h"
+]])
+file(WRITE "${RunCMake_TEST_BINARY_DIR}/MakeDependStampRemoved.h" [[
+#define MakeDependStamp 1
+]])
@@ -0,0 +1,4 @@
+file(REMOVE "${RunCMake_TEST_BINARY_DIR}/MakeDependStampRemoved.h")
+file(WRITE "${RunCMake_TEST_BINARY_DIR}/MakeDependStamp.h" [[
+#define MakeDependStamp 2
+]])
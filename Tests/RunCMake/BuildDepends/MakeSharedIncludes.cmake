@@ -0,0 +1,43 @@
+enable_language(C)
+include_directories(${CMAKE_CURRENT_BINARY_DIR})
+set(exes "")
+set(pairs "")
+set(depends "")
+foreach(n RANGE 1 4)
+  add_executable(MakeSharedIncludes${n} MakeSharedIncludes.c)
+  string(APPEND exes "  \"$<TARGET_FILE:MakeSharedIncludes${n}>\"\n")
+  string(APPEND pairs "  \"$<TARGET_FILE:MakeSharedIncludes${n}>|${CMAKE_CURRENT_BINARY_DIR}/MakeSharedIncludes.h\"\n")
+  string(APPEND depends "  \"${CMAKE_CURRENT_BINARY_DIR}/CMakeFiles/MakeSharedIncludes${n}.dir/depend.make\"\n")
+endforeach()
+file(GENERATE OUTPUT ${CMAKE_CURRENT_BINARY_DIR}/check-$<LOWER_CASE:$<CONFIG>>.cmake CONTENT "
+set(check_pairs
+${pairs})
+set(check_exes
+${exes})
+# Headers in the build tree are scanned by their relative path.
+set(scanned
+  \"${CMAKE_CURRENT_SOURCE_DIR}/MakeSharedIncludes.c\"
+  MakeSharedIncludes.h
+  MakeSharedIncludesValue.h
+  )
+if(check_step EQUAL 2)
+  # Every target must scan again to find the new header.
+  list(APPEND scanned MakeSharedIncludesNew.h)
+  foreach(d
+${depends}    )
+    file(STRINGS \"\${d}\" new REGEX \"MakeSharedIncludesNew[.]h\")
+    if(NOT new)
+      string(APPEND RunCMake_TEST_FAILED \"\\n '\${d}' does not list MakeSharedIncludesNew.h\\n\")
+    endif()
+  endforeach()
+endif()
+# Targets scanned concurrently must not lose each other's entries in the
+# shared include cache.
+foreach(f IN LISTS scanned)
+  string(MD5 h \"\${f}\")
+  file(GLOB entry \"${CMAKE_CURRENT_BINARY_DIR}/CMakeFiles/CMakeIncludeCache/*/\${h}.includecache\")
+  if(NOT entry)
+    string(APPEND RunCMake_TEST_FAILED \"\\n No shared include cache entry for '\${f}'\\n\")
+  endif()
+endforeach()
+")
@@ -0,0 +1,7 @@
+file(WRITE "${RunCMake_TEST_BINARY_DIR}/MakeSharedIncludes.h" [[
+#include "MakeSharedIncludesValue.h"
+#define MakeSharedIncludes MakeSharedIncludesValue
+]])
+file(WRITE "${RunCMake_TEST_BINARY_DIR}/MakeSharedIncludesValue.h" [[
+#define MakeSharedIncludesValue 1
+]])
@@ -0,0 +1,6 @@
+file(WRITE "${RunCMake_TEST_BINARY_DIR}/MakeSharedIncludesValue.h" [[
+#include "MakeSharedIncludesNew.h"
+]])
+file(WRITE "${RunCMake_TEST_BINARY_DIR}/MakeSharedIncludesNew.h" [[
+#define MakeSharedIncludesValue 2
+]])
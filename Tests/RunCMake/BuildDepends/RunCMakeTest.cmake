@@ -65,6 +65,17 @@ unset(RunCMake_TEST_SOURCE_DIR)
 
 if(RunCMake_GENERATOR MATCHES "Make")
   run_BuildDepends(MakeCustomIncludes)
+  run_BuildDepends(MakeCompilerDepends)
+  # Scan targets sharing headers concurrently.
+  set(ENV{CMAKE_BUILD_PARALLEL_LEVEL} 4)
+  run_BuildDepends(MakeSharedIncludes)
+  unset(ENV{CMAKE_BUILD_PARALLEL_LEVEL})
+  run_BuildDepends(MakeDependStamp)
+  set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/MakeDependStamp-build)
+  set(RunCMake_TEST_NO_CLEAN 1)
+  run_cmake_command(MakeDependStamp-noop ${CMAKE_COMMAND} --build . --config Debug -- VERBOSE=1)
+  unset(RunCMake_TEST_NO_CLEAN)
+  unset(RunCMake_TEST_BINARY_DIR)
   if(NOT "${RunCMake_BINARY_DIR}" STREQUAL "${RunCMake_SOURCE_DIR}")
     run_BuildDepends(MakeInProjectOnly)
   endif()
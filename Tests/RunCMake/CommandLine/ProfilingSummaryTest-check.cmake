@@ -0,0 +1,78 @@
+if (NOT EXISTS ${ProfilingTestOutput})
+  set(RunCMake_TEST_FAILED "Expected ${ProfilingTestOutput} to exists")
+  return()
+endif()
+
+file(READ "${ProfilingTestOutput}" summary)
+
+string(JSON calls ERROR_VARIABLE err
+  GET "${summary}" commands __testing_command_case calls)
+if (err)
+  set(RunCMake_TEST_FAILED "No summary of the function calls:\n ${err}")
+  return()
+endif()
+if (NOT calls EQUAL 2)
+  set(RunCMake_TEST_FAILED "Expected 2 calls of the function, got ${calls}")
+  return()
+endif()
+
+string(JSON slowest GET "${summary}" commands __testing_command_case slowestLocation)
+if (NOT slowest MATCHES "ProfilingSummaryTest\\.cmake:[56]$")
+  set(RunCMake_TEST_FAILED "Unexpected slowest location: ${slowest}")
+  return()
+endif()
+
+string(JSON memory ERROR_VARIABLE err
+  GET "${summary}" commands __testing_command_case inclusiveMemory)
+if (err)
+  set(RunCMake_TEST_FAILED "No memory summary of the function calls:\n ${err}")
+  return()
+endif()
+
+string(JSON directoryCalls ERROR_VARIABLE err
+  GET "${summary}" directories "${RunCMake_SOURCE_DIR}" calls)
+if (err)
+  set(RunCMake_TEST_FAILED "No summary of the test directory:\n ${err}")
+  return()
+endif()
+string(JSON directoryMemory ERROR_VARIABLE err
+  GET "${summary}" directories "${RunCMake_SOURCE_DIR}" exclusiveMemory)
+if (err)
+  set(RunCMake_TEST_FAILED "No memory summary of the test directory:\n ${err}")
+  return()
+endif()
+
+string(JSON location ERROR_VARIABLE err
+  GET "${summary}" locations "${RunCMake_SOURCE_DIR}/ProfilingSummaryTest.cmake:2" command)
+if (NOT location STREQUAL "set")
+  set(RunCMake_TEST_FAILED "No summary of the set call site:\n ${err}")
+  return()
+endif()
+string(JSON setCalls GET "${summary}" locations "${RunCMake_SOURCE_DIR}/ProfilingSummaryTest.cmake:2" calls)
+if (NOT setCalls EQUAL 2)
+  set(RunCMake_TEST_FAILED "Expected 2 calls of set, got ${setCalls}")
+  return()
+endif()
+
+string(JSON counters ERROR_VARIABLE err GET "${summary}" counters "listfile cache")
+if (err)
+  set(RunCMake_TEST_FAILED "No listfile cache counters in summary:\n ${err}")
+endif()
+
+string(JSON genexCounters ERROR_VARIABLE err
+  GET "${summary}" counters "genex evaluation cache")
+if (err)
+  set(RunCMake_TEST_FAILED "No genex evaluation cache counters in summary:\n ${err}")
+endif()
+
+string(JSON fileSystemCounters ERROR_VARIABLE err
+  GET "${summary}" counters "file system cache")
+if (err)
+  set(RunCMake_TEST_FAILED "No file system cache counters in summary:\n ${err}")
+endif()
+
+string(JSON linkCounters ERROR_VARIABLE err
+  GET "${summary}" counters "link dependency cache")
+if (err)
+  set(RunCMake_TEST_FAILED "No link dependency cache counters in summary:\n ${err}")
+endif()
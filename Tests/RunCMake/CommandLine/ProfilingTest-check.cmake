@@ -29,3 +29,15 @@ if (NOT numInvocations EQUAL 1)
   set(RunCMake_TEST_FAILED
       "Unexpected number of lowercase command names: ${numInvocations}")
 endif()
+
+file(STRINGS ${ProfilingTestOutput} listFileCacheCounters
+  REGEX [["name"[ ]*:[ ]*"listfile cache"]])
+if ("${listFileCacheCounters}" STREQUAL "")
+  set(RunCMake_TEST_FAILED "No listfile cache counters in profiling output")
+endif()
+
+file(STRINGS ${ProfilingTestOutput} memoryCounters
+  REGEX [["name"[ ]*:[ ]*"memory"]])
+if ("${memoryCounters}" STREQUAL "")
+  set(RunCMake_TEST_FAILED "No memory counters in profiling output")
+endif()
@@ -824,3 +824,9 @@ set(ProfilingTestOutput ${RunCMake_TEST_BINARY_DIR}/output.json)
 set(RunCMake_TEST_OPTIONS --profiling-format=google-trace --profiling-output=${ProfilingTestOutput})
 run_cmake(ProfilingTest)
 unset(RunCMake_TEST_OPTIONS)
+
+set(RunCMake_TEST_BINARY_DIR "${RunCMake_BINARY_DIR}/profiling-summary-test")
+set(ProfilingTestOutput ${RunCMake_TEST_BINARY_DIR}/summary.json)
+set(RunCMake_TEST_OPTIONS --profiling-format=summary --profiling-output=${ProfilingTestOutput})
+run_cmake(ProfilingSummaryTest)
+unset(RunCMake_TEST_OPTIONS)
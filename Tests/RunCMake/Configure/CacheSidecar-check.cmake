@@ -0,0 +1,4 @@
+set(sidecar "${RunCMake_TEST_BINARY_DIR}/CMakeFiles/CMakeCache.bin")
+if(NOT EXISTS "${sidecar}")
+  set(RunCMake_TEST_FAILED "Binary cache file not written:\n  ${sidecar}")
+endif()
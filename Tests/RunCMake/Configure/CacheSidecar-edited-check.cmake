@@ -0,0 +1,11 @@
+set(sidecar "${RunCMake_TEST_BINARY_DIR}/CMakeFiles/CMakeCache.bin")
+if(NOT EXISTS "${sidecar}")
+  set(RunCMake_TEST_FAILED "Binary cache file not written:\n  ${sidecar}")
+  return()
+endif()
+file(READ "${sidecar_summary}" summary)
+string(JSON hits GET "${summary}" counters "cache sidecar" hits)
+string(JSON misses GET "${summary}" counters "cache sidecar" misses)
+if(NOT misses EQUAL 1)
+  set(RunCMake_TEST_FAILED "The edited cache was not parsed from the text file (hits: ${hits}, misses: ${misses}).")
+endif()
@@ -0,0 +1,4 @@
+set(sidecar "${RunCMake_TEST_BINARY_DIR}/CMakeFiles/CMakeCache.bin")
+if(EXISTS "${sidecar}")
+  set(RunCMake_TEST_FAILED "Binary cache file not removed:\n  ${sidecar}")
+endif()
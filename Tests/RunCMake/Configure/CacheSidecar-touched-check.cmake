@@ -0,0 +1,11 @@
+set(sidecar "${RunCMake_TEST_BINARY_DIR}/CMakeFiles/CMakeCache.bin")
+if(NOT EXISTS "${sidecar}")
+  set(RunCMake_TEST_FAILED "Binary cache file not written:\n  ${sidecar}")
+  return()
+endif()
+file(READ "${sidecar_summary}" summary)
+string(JSON hits GET "${summary}" counters "cache sidecar" hits)
+string(JSON misses GET "${summary}" counters "cache sidecar" misses)
+if(NOT hits GREATER 0 OR NOT misses EQUAL 0)
+  set(RunCMake_TEST_FAILED "The touched cache was not loaded from the binary copy (hits: ${hits}, misses: ${misses}).")
+endif()
@@ -0,0 +1 @@
+message(STATUS "SIDECAR_VALUE='${SIDECAR_VALUE}'")
@@ -51,6 +51,32 @@ run_cmake(RemoveCache)
 file(REMOVE "${RunCMake_TEST_BINARY_DIR}/CMakeCache.txt")
 run_cmake(RemoveCache)
 
+# Use a single build tree for a few tests without cleaning.
+set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/CacheSidecar-build)
+set(RunCMake_TEST_NO_CLEAN 1)
+file(REMOVE_RECURSE "${RunCMake_TEST_BINARY_DIR}")
+file(MAKE_DIRECTORY "${RunCMake_TEST_BINARY_DIR}")
+set(RunCMake_TEST_OPTIONS -DCMAKE_CACHE_SIDECAR=ON -DSIDECAR_VALUE:STRING=1)
+run_cmake(CacheSidecar)
+unset(RunCMake_TEST_OPTIONS)
+# Tell from the profiling counters whether the binary cache was loaded.
+set(sidecar_summary "${RunCMake_TEST_BINARY_DIR}/CacheSidecar-summary.json")
+run_cmake_command(CacheSidecar-unchanged ${CMAKE_COMMAND} .
+  --profiling-format=summary --profiling-output=${sidecar_summary})
+set(cache "${RunCMake_TEST_BINARY_DIR}/CMakeCache.txt")
+file(TOUCH "${cache}")
+run_cmake_command(CacheSidecar-touched ${CMAKE_COMMAND} .
+  --profiling-format=summary --profiling-output=${sidecar_summary})
+file(READ "${cache}" content)
+string(REPLACE "SIDECAR_VALUE:STRING=1" "SIDECAR_VALUE:STRING=2" content "${content}")
+file(WRITE "${cache}" "${content}")
+run_cmake_command(CacheSidecar-edited ${CMAKE_COMMAND} .
+  --profiling-format=summary --profiling-output=${sidecar_summary})
+unset(sidecar_summary)
+run_cmake_command(CacheSidecar-off ${CMAKE_COMMAND} -DCMAKE_CACHE_SIDECAR=OFF .)
+unset(RunCMake_TEST_BINARY_DIR)
+unset(RunCMake_TEST_NO_CLEAN)
+
 if(NOT RunCMake_GENERATOR MATCHES "^Ninja Multi-Config$")
   run_cmake(NoCMAKE_CROSS_CONFIGS)
   run_cmake(NoCMAKE_DEFAULT_BUILD_TYPE)
@@ -0,0 +1,35 @@
+if(RunCMake_GENERATOR_IS_MULTI_CONFIG)
+  set(configs Debug Release)
+else()
+  set(configs Debug)
+endif()
+
+foreach(t one two)
+  foreach(c IN LISTS configs)
+    set(file "${RunCMake_TEST_BINARY_DIR}/EvaluationCache-${t}-${c}.txt")
+    if(NOT EXISTS "${file}")
+      string(APPEND RunCMake_TEST_FAILED "Missing ${file}\n")
+      continue()
+    endif()
+    file(READ "${file}" content)
+    set(expected "config=${c}\nprop=${t}-value\n")
+    if(NOT content STREQUAL expected)
+      string(APPEND RunCMake_TEST_FAILED
+        "${file} has content:\n [[${content}]]\nbut expected:\n [[${expected}]]\n")
+    endif()
+    file(READ "${RunCMake_TEST_BINARY_DIR}/EvaluationCache-${t}-${c}-again.txt" content)
+    if(NOT content STREQUAL "config=${c}\n")
+      string(APPEND RunCMake_TEST_FAILED
+        "EvaluationCache-${t}-${c}-again.txt has content:\n [[${content}]]\n")
+    endif()
+  endforeach()
+endforeach()
+
+file(READ "${EvaluationCacheSummary}" summary)
+string(JSON hits ERROR_VARIABLE err
+  GET "${summary}" counters "genex evaluation cache" hits)
+if(err)
+  string(APPEND RunCMake_TEST_FAILED "No genex evaluation cache counters:\n ${err}\n")
+elseif(NOT hits GREATER 0)
+  string(APPEND RunCMake_TEST_FAILED "Expected genex evaluation cache hits, got ${hits}\n")
+endif()
@@ -0,0 +1,15 @@
+cmake_policy(SET CMP0070 NEW)
+
+foreach(t one two)
+  add_custom_target(${t})
+  set_property(TARGET ${t} PROPERTY prop ${t}-value)
+
+  # The condition is evaluated again for the second file and may be reused.
+  # The $<TARGET_PROPERTY:prop> content depends on the consumer.
+  file(GENERATE OUTPUT EvaluationCache-${t}-$<CONFIG>.txt
+    CONTENT "config=$<CONFIG>\nprop=$<TARGET_PROPERTY:prop>\n"
+    CONDITION "$<BOOL:1>" TARGET ${t})
+  file(GENERATE OUTPUT EvaluationCache-${t}-$<CONFIG>-again.txt
+    CONTENT "config=$<CONFIG>\n"
+    CONDITION "$<BOOL:1>" TARGET ${t})
+endforeach()
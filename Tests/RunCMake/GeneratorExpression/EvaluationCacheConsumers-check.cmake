@@ -0,0 +1,32 @@
+if(RunCMake_GENERATOR_IS_MULTI_CONFIG)
+  set(configs Debug Release)
+else()
+  set(configs Debug)
+endif()
+
+foreach(t IN LISTS consumers)
+  foreach(c IN LISTS configs)
+    set(file "${RunCMake_TEST_BINARY_DIR}/EvaluationCache-${t}-${c}.txt")
+    if(NOT EXISTS "${file}")
+      string(APPEND RunCMake_TEST_FAILED "Missing ${file}\n")
+      continue()
+    endif()
+    file(READ "${file}" content)
+    if(c STREQUAL "Debug")
+      set(expected "DEP_ALWAYS;DEP_DEBUG;DEP_ON\n")
+    else()
+      set(expected "DEP_ALWAYS;DEP_ON\n")
+    endif()
+    if(NOT content STREQUAL expected)
+      string(APPEND RunCMake_TEST_FAILED
+        "${file} has content:\n [[${content}]]\nbut expected:\n [[${expected}]]\n")
+    endif()
+  endforeach()
+endforeach()
+
+file(READ "${RunCMake_TEST_BINARY_DIR}/summary.json" summary)
+string(JSON hits ERROR_VARIABLE err
+  GET "${summary}" counters "genex evaluation cache" hits)
+if(err)
+  string(APPEND RunCMake_TEST_FAILED "No genex evaluation cache counters:\n ${err}\n")
+endif()
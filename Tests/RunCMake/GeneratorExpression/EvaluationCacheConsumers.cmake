@@ -0,0 +1,13 @@
+cmake_policy(SET CMP0070 NEW)
+
+# The usage requirements of 'dep' are evaluated for each consumer.
+add_library(dep INTERFACE)
+set_property(TARGET dep PROPERTY INTERFACE_COMPILE_DEFINITIONS
+  "DEP_ALWAYS;$<$<CONFIG:Debug>:DEP_DEBUG>;$<$<BOOL:1>:DEP_ON>")
+
+foreach(t IN LISTS consumers)
+  add_library(${t} INTERFACE)
+  target_link_libraries(${t} INTERFACE dep)
+  file(GENERATE OUTPUT EvaluationCache-${t}-$<CONFIG>.txt
+    CONTENT "$<TARGET_PROPERTY:${t},INTERFACE_COMPILE_DEFINITIONS>\n")
+endforeach()
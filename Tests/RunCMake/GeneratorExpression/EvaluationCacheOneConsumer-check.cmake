@@ -0,0 +1,2 @@
+set(consumers one)
+include(${CMAKE_CURRENT_LIST_DIR}/EvaluationCacheConsumers-check.cmake)
@@ -0,0 +1,2 @@
+set(consumers one)
+include(EvaluationCacheConsumers.cmake)
@@ -0,0 +1,12 @@
+set(consumers one two)
+include(${CMAKE_CURRENT_LIST_DIR}/EvaluationCacheConsumers-check.cmake)
+
+# The second consumer must reuse the results evaluated for the first.
+file(READ "${RunCMake_BINARY_DIR}/EvaluationCacheOneConsumer-build/summary.json"
+  summary)
+string(JSON oneHits GET "${summary}" counters "genex evaluation cache" hits)
+if(NOT hits GREATER oneHits)
+  string(APPEND RunCMake_TEST_FAILED
+    "Expected more genex evaluation cache hits with two consumers "
+    "(${hits}) than with one (${oneHits})\n")
+endif()
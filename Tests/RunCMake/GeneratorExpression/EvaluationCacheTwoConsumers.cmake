@@ -0,0 +1,2 @@
+set(consumers one two)
+include(EvaluationCacheConsumers.cmake)
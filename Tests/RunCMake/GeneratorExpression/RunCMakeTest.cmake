@@ -58,6 +58,29 @@ else()
 endif()
 run_cmake(CONFIG-empty-entries)
 
+set(EvaluationCacheSummary ${RunCMake_BINARY_DIR}/EvaluationCache-summary.json)
+if(RunCMake_GENERATOR_IS_MULTI_CONFIG)
+  set(RunCMake_TEST_OPTIONS [==[-DCMAKE_CONFIGURATION_TYPES=Debug;Release]==])
+else()
+  set(RunCMake_TEST_OPTIONS -DCMAKE_BUILD_TYPE=Debug)
+endif()
+list(APPEND RunCMake_TEST_OPTIONS
+  --profiling-format=summary --profiling-output=${EvaluationCacheSummary})
+run_cmake(EvaluationCache)
+unset(RunCMake_TEST_OPTIONS)
+
+foreach(case IN ITEMS EvaluationCacheOneConsumer EvaluationCacheTwoConsumers)
+  if(RunCMake_GENERATOR_IS_MULTI_CONFIG)
+    set(RunCMake_TEST_OPTIONS [==[-DCMAKE_CONFIGURATION_TYPES=Debug;Release]==])
+  else()
+    set(RunCMake_TEST_OPTIONS -DCMAKE_BUILD_TYPE=Debug)
+  endif()
+  list(APPEND RunCMake_TEST_OPTIONS --profiling-format=summary
+    --profiling-output=${RunCMake_BINARY_DIR}/${case}-build/summary.json)
+  run_cmake(${case})
+  unset(RunCMake_TEST_OPTIONS)
+endforeach()
+
 set(RunCMake_TEST_OPTIONS -DCMAKE_POLICY_DEFAULT_CMP0085:STRING=OLD)
 run_cmake(CMP0085-OLD)
 unset(RunCMake_TEST_OPTIONS)
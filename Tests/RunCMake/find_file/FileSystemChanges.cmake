@@ -0,0 +1,18 @@
+# Results must follow files created and removed during the configure step.
+set(dir "${CMAKE_CURRENT_BINARY_DIR}/FileSystemChanges")
+file(REMOVE_RECURSE "${dir}")
+foreach(step IN ITEMS none WRITE REMOVE MAKE_DIRECTORY execute_process)
+  if(step STREQUAL "WRITE")
+    file(WRITE "${dir}/sub/Changed.h" "")
+  elseif(step STREQUAL "REMOVE")
+    file(REMOVE "${dir}/sub/Changed.h")
+  elseif(step STREQUAL "MAKE_DIRECTORY")
+    file(MAKE_DIRECTORY "${dir}/sub/Changed.h")
+  elseif(step STREQUAL "execute_process")
+    execute_process(COMMAND ${CMAKE_COMMAND} -E remove_directory "${dir}/sub/Changed.h")
+    execute_process(COMMAND ${CMAKE_COMMAND} -E touch "${dir}/sub/Changed.h")
+  endif()
+  unset(Changed_File CACHE)
+  find_file(Changed_File NAMES Changed.h PATHS "${dir}/sub" NO_DEFAULT_PATH)
+  message(STATUS "${step}: Changed_File='${Changed_File}'")
+endforeach()
@@ -1,5 +1,6 @@
 include(RunCMake)
 
+run_cmake(FileSystemChanges)
 run_cmake(FromPATHEnv)
 run_cmake(FromPrefixPath)
 run_cmake(PrefixInPATH)
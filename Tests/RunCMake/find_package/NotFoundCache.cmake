@@ -0,0 +1,5 @@
+set(CMAKE_FIND_PACKAGE_CACHE_NOT_FOUND ON)
+set(CMAKE_FIND_DEBUG_MODE ON)
+find_package(Cached CONFIG PATHS ${CMAKE_CURRENT_BINARY_DIR}/prefix NO_DEFAULT_PATH)
+set(CMAKE_FIND_DEBUG_MODE OFF)
+message(STATUS "Cached_FOUND='${Cached_FOUND}'")
@@ -18,6 +18,21 @@ run_cmake(MissingConfigOneName)
 run_cmake(MissingConfigRequired)
 run_cmake(MissingConfigVersion)
 run_cmake(MixedModeOptions)
+
+function(run_NotFoundCache)
+  set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/NotFoundCache-build)
+  file(REMOVE_RECURSE "${RunCMake_TEST_BINARY_DIR}")
+  file(MAKE_DIRECTORY "${RunCMake_TEST_BINARY_DIR}/prefix")
+  set(RunCMake_TEST_NO_CLEAN 1)
+  # Let the prefix time stamp age past the file system resolution.
+  execute_process(COMMAND ${CMAKE_COMMAND} -E sleep 2.5)
+  run_cmake(NotFoundCache)
+  run_cmake_command(NotFoundCache-unchanged ${CMAKE_COMMAND} .)
+  file(WRITE "${RunCMake_TEST_BINARY_DIR}/prefix/CachedConfig.cmake" "")
+  run_cmake_command(NotFoundCache-changed ${CMAKE_COMMAND} .)
+endfunction()
+run_NotFoundCache()
+
 run_cmake(PackageRoot)
 run_cmake(PackageRootNestedConfig)
 run_cmake(PackageRootNestedModule)
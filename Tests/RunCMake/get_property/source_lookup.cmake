@@ -0,0 +1,19 @@
+function (check_source_file_property label file prop)
+  get_property(gp_val
+    SOURCE "${file}"
+    PROPERTY "${prop}")
+
+  message("${label}: -->${gp_val}<--")
+endfunction ()
+
+# A source without an extension is resolved by its first lookup with one.
+set_property(SOURCE sub/stem PROPERTY custom ambiguous)
+check_source_file_property(source ${CMAKE_CURRENT_SOURCE_DIR}/sub/stem.c custom)
+
+# A source with a full path and the same stem in another directory.
+set_property(SOURCE ${CMAKE_CURRENT_BINARY_DIR}/sub/stem.c PROPERTY custom exact)
+check_source_file_property(binary ${CMAKE_CURRENT_BINARY_DIR}/sub/stem.c custom)
+
+# A relative path may name either of them.  The one created first wins.
+check_source_file_property(relative sub/stem.c custom)
+check_source_file_property(header sub/stem.h custom)
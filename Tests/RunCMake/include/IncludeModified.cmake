@@ -0,0 +1,21 @@
+set(inc "${CMAKE_CURRENT_BINARY_DIR}/modified.cmake")
+
+file(WRITE "${inc}" "set(value 1)\n")
+include("${inc}")
+if(NOT value STREQUAL "1")
+  message(FATAL_ERROR "First include set value to '${value}', not '1'")
+endif()
+
+# Re-including the unchanged file must give the same result.
+set(value)
+include("${inc}")
+if(NOT value STREQUAL "1")
+  message(FATAL_ERROR "Second include set value to '${value}', not '1'")
+endif()
+
+# A modified file must not be served from the parsed listfile cache.
+file(WRITE "${inc}" "set(value 2)\n")
+include("${inc}")
+if(NOT value STREQUAL "2")
+  message(FATAL_ERROR "Modified include set value to '${value}', not '2'")
+endif()
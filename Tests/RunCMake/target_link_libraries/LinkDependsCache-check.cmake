@@ -0,0 +1,51 @@
+set(reply_dir "${RunCMake_TEST_BINARY_DIR}/.cmake/api/v1/reply")
+file(GLOB index_file "${reply_dir}/index-*.json")
+file(READ "${index_file}" index)
+string(JSON codemodel_file GET "${index}" reply codemodel-v2 jsonFile)
+file(READ "${reply_dir}/${codemodel_file}" codemodel)
+string(JSON targets GET "${codemodel}" configurations 0 targets)
+string(JSON num_targets LENGTH "${targets}")
+math(EXPR last "${num_targets} - 1")
+foreach(i RANGE ${last})
+  string(JSON name GET "${targets}" ${i} name)
+  string(JSON target_file GET "${targets}" ${i} jsonFile)
+  file(READ "${reply_dir}/${target_file}" target)
+  set(link_${name} "")
+  string(JSON fragments ERROR_VARIABLE err GET "${target}" link commandFragments)
+  if(NOT err)
+    string(JSON num_fragments LENGTH "${fragments}")
+    math(EXPR last_fragment "${num_fragments} - 1")
+    foreach(j RANGE ${last_fragment})
+      string(JSON fragment GET "${fragments}" ${j} fragment)
+      string(APPEND link_${name} " ${fragment}")
+    endforeach()
+  endif()
+endforeach()
+
+function(check_link target expect reject)
+  if(expect AND NOT link_${target} MATCHES "${expect}")
+    string(APPEND RunCMake_TEST_FAILED
+      "Target ${target} does not link '${expect}':\n ${link_${target}}\n")
+  endif()
+  if(reject AND link_${target} MATCHES "${reject}")
+    string(APPEND RunCMake_TEST_FAILED
+      "Target ${target} links '${reject}':\n ${link_${target}}\n")
+  endif()
+  set(RunCMake_TEST_FAILED "${RunCMake_TEST_FAILED}" PARENT_SCOPE)
+endfunction()
+
+check_link(head1 "dep1" "dep2")
+check_link(head2 "dep2" "dep1")
+check_link(self1 "self2" "")
+check_link(self2 "" "self2")
+check_link(vars1 "extlib" "dep2")
+check_link(vars2 "extlib.*dep2" "")
+check_link(plain1 "plain" "")
+check_link(plain2 "plain" "")
+
+file(READ "${RunCMake_TEST_BINARY_DIR}/summary.json" summary)
+string(JSON hits GET "${summary}" counters "link dependency cache" hits)
+if(NOT hits GREATER 0)
+  string(APPEND RunCMake_TEST_FAILED
+    "Targets linking the same items did not share link dependencies.\n")
+endif()
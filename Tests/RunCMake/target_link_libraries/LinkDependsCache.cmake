@@ -0,0 +1,36 @@
+cmake_policy(VERSION 3.18)
+enable_language(C)
+
+add_library(dep1 STATIC lib.c)
+add_library(dep2 STATIC lib.c)
+
+# Targets linking an interface that depends on the target being linked.
+add_library(head INTERFACE)
+target_link_libraries(head INTERFACE $<TARGET_PROPERTY:USE_DEP>)
+add_executable(head1 empty.c)
+set_property(TARGET head1 PROPERTY USE_DEP dep1)
+target_link_libraries(head1 PRIVATE head)
+add_executable(head2 empty.c)
+set_property(TARGET head2 PROPERTY USE_DEP dep2)
+target_link_libraries(head2 PRIVATE head)
+
+# Targets linking an interface that names one of them.
+add_library(self INTERFACE)
+target_link_libraries(self INTERFACE self2)
+add_executable(self1 empty.c)
+target_link_libraries(self1 PRIVATE self)
+add_library(self2 SHARED lib.c)
+target_link_libraries(self2 PRIVATE self)
+
+# Targets linking an item whose old-style dependencies are defined in the
+# directory of only one of them.
+add_executable(vars1 empty.c)
+target_link_libraries(vars1 PRIVATE extlib)
+add_subdirectory(LinkDependsCache)
+
+# Targets linking the same library.
+add_library(plain SHARED lib.c)
+add_executable(plain1 empty.c)
+target_link_libraries(plain1 PRIVATE plain)
+add_executable(plain2 empty.c)
+target_link_libraries(plain2 PRIVATE plain)
@@ -30,3 +30,16 @@ run_cmake(StaticPrivateDepNotExported)
 run_cmake(StaticPrivateDepNotTarget)
 run_cmake(UNKNOWN-IMPORTED-GLOBAL)
 run_cmake(empty_keyword_args)
+
+# Request the link lines of all targets from the file API.
+set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/LinkDependsCache-build)
+set(RunCMake_TEST_NO_CLEAN 1)
+file(REMOVE_RECURSE "${RunCMake_TEST_BINARY_DIR}")
+file(WRITE "${RunCMake_TEST_BINARY_DIR}/.cmake/api/v1/query/codemodel-v2" "")
+set(RunCMake_TEST_OPTIONS
+  --profiling-format=summary
+  --profiling-output=${RunCMake_TEST_BINARY_DIR}/summary.json)
+run_cmake(LinkDependsCache)
+unset(RunCMake_TEST_OPTIONS)
+unset(RunCMake_TEST_NO_CLEAN)
+unset(RunCMake_TEST_BINARY_DIR)
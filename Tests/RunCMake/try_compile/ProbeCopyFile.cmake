@@ -0,0 +1,6 @@
+enable_language(C)
+try_compile(RESULT ${CMAKE_CURRENT_BINARY_DIR}
+  SOURCES ${CMAKE_CURRENT_SOURCE_DIR}/src.c
+  COPY_FILE ${CMAKE_CURRENT_BINARY_DIR}/copy
+  PROBE OTHER SOURCES ${CMAKE_CURRENT_SOURCE_DIR}/src.c
+  )
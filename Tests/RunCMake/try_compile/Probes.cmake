@@ -0,0 +1,23 @@
+enable_language(C)
+try_compile(first ${CMAKE_CURRENT_BINARY_DIR}
+  SOURCES ${CMAKE_CURRENT_SOURCE_DIR}/src.c
+  PROBE second SOURCES ${CMAKE_CURRENT_SOURCE_DIR}/src.c
+    COMPILE_DEFINITIONS -DPP_ERROR
+  PROBE third SOURCES ${CMAKE_CURRENT_SOURCE_DIR}/src.c
+  PROBE fourth SOURCES ${CMAKE_CURRENT_SOURCE_DIR}/src.c
+    LINK_LIBRARIES not_a_library_for_try_compile
+  OUTPUT_VARIABLE out
+  )
+foreach(var first third)
+  if(NOT ${var})
+    message(FATAL_ERROR "try_compile probe ${var} failed:\n${out}")
+  endif()
+endforeach()
+foreach(var second fourth)
+  if(${var})
+    message(FATAL_ERROR "try_compile probe ${var} should have failed:\n${out}")
+  endif()
+endforeach()
+if(NOT out MATCHES "PP_ERROR is defined")
+  message(FATAL_ERROR "try_compile output does not contain the error:\n${out}")
+endif()
@@ -0,0 +1,44 @@
+enable_language(C)
+set(cache_dir ${CMAKE_CURRENT_BINARY_DIR}/TryCompileCache)
+if(NOT CMAKE_TRY_COMPILE_CACHE_DIR STREQUAL cache_dir)
+  message(FATAL_ERROR "CMAKE_TRY_COMPILE_CACHE_DIR is\n"
+    "  ${CMAKE_TRY_COMPILE_CACHE_DIR}\nbut should be\n  ${cache_dir}")
+endif()
+
+try_compile(result ${CMAKE_CURRENT_BINARY_DIR}
+  SOURCES ${CMAKE_CURRENT_SOURCE_DIR}/src.c
+  OUTPUT_VARIABLE out
+  )
+if(NOT result)
+  message(FATAL_ERROR "try_compile failed:\n${out}")
+endif()
+file(GLOB entries ${cache_dir}/*.txt)
+list(LENGTH entries count)
+if(NOT count EQUAL 1)
+  message(FATAL_ERROR "Expected one cache entry, found:\n  ${entries}")
+endif()
+
+# Replace the stored result to show that the test project is not built.
+file(WRITE ${entries} "result=1\nfrom cache")
+try_compile(result ${CMAKE_CURRENT_BINARY_DIR}
+  SOURCES ${CMAKE_CURRENT_SOURCE_DIR}/src.c
+  OUTPUT_VARIABLE out
+  )
+if(result OR NOT out STREQUAL "from cache")
+  message(FATAL_ERROR "try_compile did not use the cached result:\n${out}")
+endif()
+
+# A check with different flags is not answered by the cache.
+try_compile(result ${CMAKE_CURRENT_BINARY_DIR}
+  SOURCES ${CMAKE_CURRENT_SOURCE_DIR}/src.c
+  COMPILE_DEFINITIONS -DRESULT_CACHE
+  OUTPUT_VARIABLE out
+  )
+if(NOT result)
+  message(FATAL_ERROR "try_compile failed:\n${out}")
+endif()
+file(GLOB entries ${cache_dir}/*.txt)
+list(LENGTH entries count)
+if(NOT count EQUAL 2)
+  message(FATAL_ERROR "Expected two cache entries, found:\n  ${entries}")
+endif()
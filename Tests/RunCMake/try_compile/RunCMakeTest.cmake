@@ -24,6 +24,14 @@ unset(RunCMake_TEST_OPTIONS)
 run_cmake(TargetTypeExe)
 run_cmake(TargetTypeInvalid)
 run_cmake(TargetTypeStatic)
+run_cmake(Probes)
+run_cmake(ProbeCopyFile)
+run_cmake(ProbeNoSources)
+
+set(RunCMake_TEST_OPTIONS
+  --try-compile-cache=${RunCMake_BINARY_DIR}/ResultCache-build/TryCompileCache)
+run_cmake(ResultCache)
+unset(RunCMake_TEST_OPTIONS)
 
 if (CMAKE_SYSTEM_NAME MATCHES "^(Linux|Darwin|Windows)$" AND
     CMAKE_C_COMPILER_ID MATCHES "^(MSVC|GNU|Clang|AppleClang)$")